@@ -0,0 +1,59 @@
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    const size_t count = 1 << 20;
+
+    // Independent short strings, scattered over the heap
+    std::vector<std::string> storage;
+    storage.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        storage.push_back("host" + std::to_string(i % 977) + ".cpu.load" + std::string(i % 7, 'x'));
+
+    std::vector<efp::StringView> inputs;
+    size_t bytes = 0;
+    for (const auto &s : storage)
+    {
+        inputs.push_back(efp::StringView(s.data(), s.size()));
+        bytes += s.size();
+    }
+
+    const size_t iterations = 10;
+    const Span<efp::StringView> span_inputs(inputs.data(), inputs.size());
+
+    const auto metric = tpl(alphanumeric1, skip(one_of(".")), alpha1, skip(one_of(".")), alpha1);
+    std::vector<decltype(metric(inputs[0]))> per_call_results(count);
+
+    bench("batch: parser per call", bytes, iterations, [&]()
+          {
+              size_t matched = 0;
+              for (size_t i = 0; i < count; ++i)
+              {
+                  const auto p = tpl(alphanumeric1, skip(one_of(".")), alpha1, skip(one_of(".")), alpha1);
+                  per_call_results[i] = p(inputs[i]);
+                  if (per_call_results[i])
+                      ++matched;
+              }
+              do_not_optimize(matched); });
+
+    BatchResults<efp::StringView, CallParserO<decltype(metric), efp::StringView>> results(count);
+
+    bench("batch: parse_batch", bytes, iterations, [&]()
+          {
+              const auto matched = parse_batch(metric, span_inputs, results);
+              do_not_optimize(matched); });
+
+    bench("batch: parse_batch, prefetch 8", bytes, iterations, [&]()
+          {
+              const auto matched = parse_batch<8>(metric, span_inputs, results);
+              do_not_optimize(matched); });
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#ifndef BENCH_COMMON_HPP_
+#define BENCH_COMMON_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Keeps the value observable, so the benchmarked work is not optimized out
+template <typename T>
+void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile(""
+                 :
+                 : "g"(&value)
+                 : "memory");
+#else
+    static const void *volatile sink;
+    sink = &value;
+#endif
+}
+
+// Runs f for the iterations and prints the throughput over bytes processed per iteration
+template <typename F>
+double bench(const char *name, size_t bytes, size_t iterations, const F &f)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - begin).count();
+    const double gbps = static_cast<double>(bytes) * iterations / seconds / 1e9;
+
+    printf("%-40s %8.3f GB/s\n", name, gbps);
+    return gbps;
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include <cstdint>
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+// Byte at a time LEB128 decoding, as the baseline
+static size_t decode_varint_scalar(const char *p, size_t size, uint64_t &value)
+{
+    value = 0;
+    for (size_t i = 0; i < 10 && i < size; ++i)
+    {
+        const auto b = static_cast<unsigned char>(p[i]);
+        value |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+        if (!(b & 0x80))
+            return i + 1;
+    }
+    return 0;
+}
+
+// Bit at a time field extraction, as the baseline
+static uint64_t read_bits_scalar(const char *p, size_t &offset, size_t n)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < n; ++i, ++offset)
+        value = (value << 1) | ((static_cast<unsigned char>(p[offset / 8]) >> (7 - offset % 8)) & 1);
+    return value;
+}
+
+int main()
+{
+    const size_t count = 1 << 20;
+
+    // Mostly short varints, as field tags and lengths, with some of every length up to 8 bytes
+    std::string varints;
+    uint64_t state = 0x9E3779B97F4A7C15;
+    for (size_t i = 0; i < count; ++i)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        uint64_t v = state >> (i % 4 == 0 ? 8 + state % 48 : 57);
+        while (v >= 0x80)
+        {
+            varints.push_back(static_cast<char>((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        varints.push_back(static_cast<char>(v));
+    }
+
+    const size_t iterations = 20;
+
+    bench("binary: varint, byte at a time", varints.size(), iterations, [&]()
+          {
+              const char *p = varints.data();
+              size_t size = varints.size();
+              uint64_t sum = 0;
+              while (size > 0)
+              {
+                  uint64_t v;
+                  const size_t n = decode_varint_scalar(p, size, v);
+                  if (n == 0)
+                      break;
+                  sum += v;
+                  p += n;
+                  size -= n;
+              }
+              do_not_optimize(sum); });
+
+    bench("binary: varint_u64", varints.size(), iterations, [&]()
+          {
+              efp::StringView in(varints.data(), varints.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = varint_u64(in);
+                  if (!res)
+                      break;
+                  sum += snd(res.value());
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+
+    // Records of a big-endian header and a length-prefixed payload
+    std::string records;
+    for (size_t i = 0; i < count / 4; ++i)
+    {
+        const char header[] = {static_cast<char>(i >> 8), static_cast<char>(i), 0, 0, 0, static_cast<char>(i % 7),
+                               static_cast<char>(i % 32)};
+        records.append(header, sizeof(header));
+        records.append(i % 32, 'x');
+    }
+
+    const auto record = tpl(be_u16, be_u32, length_data(be_u8));
+
+    bench("binary: records", records.size(), iterations, [&]()
+          {
+              efp::StringView in(records.data(), records.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = record(in);
+                  if (!res)
+                      break;
+                  sum += efp::p<1>(snd(res.value())) + length(efp::p<2>(snd(res.value())));
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+
+    // Telemetry frames of 8 byte headers packing 3, 1, 12, 4, 20 and 24 bit fields
+    std::string frames;
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (size_t k = 0; k < 8; ++k)
+            frames.push_back(static_cast<char>(i * 31 + k * 7));
+    }
+
+    bench("binary: bit fields, bit at a time", frames.size(), iterations, [&]()
+          {
+              uint64_t sum = 0;
+              size_t offset = 0;
+              while (offset < frames.size() * 8)
+              {
+                  sum += read_bits_scalar(frames.data(), offset, 3);
+                  sum += read_bits_scalar(frames.data(), offset, 1);
+                  sum += read_bits_scalar(frames.data(), offset, 12);
+                  sum += read_bits_scalar(frames.data(), offset, 4);
+                  sum += read_bits_scalar(frames.data(), offset, 20);
+                  sum += read_bits_scalar(frames.data(), offset, 24);
+              }
+              do_not_optimize(sum); });
+
+    const auto frame = tpl(take_bits<3>(), bool_bit, take_bits<12>(), take_bits<4>(), take_bits<20>(), take_bits<24>());
+
+    bench("binary: bit fields", frames.size(), iterations, [&]()
+          {
+              BitCursor in(efp::StringView(frames.data(), frames.size()));
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = frame(in);
+                  if (!res)
+                      break;
+                  const auto &fields = snd(res.value());
+                  sum += efp::p<0>(fields) + efp::p<1>(fields) + efp::p<2>(fields) + efp::p<3>(fields) +
+                         efp::p<4>(fields) + efp::p<5>(fields);
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    // Quoted strings of typical lengths, one in ten with an escape
+    std::string input;
+    size_t count = 0;
+    for (size_t i = 0; input.size() < (1 << 24); ++i, ++count)
+    {
+        input += "\"some string value number " + std::to_string(i);
+        input += i % 10 == 0 ? " with a \\\"quote\\\"" : " without escapes";
+        input += "\" ";
+    }
+
+    const efp::StringView view(input.data(), input.size());
+    const size_t iterations = 10;
+
+    const auto character = alt(none_of("\"\\"), preceded(ch('\\'), anychar));
+
+    bench("escaped_string: none_of/alt per char", input.size(), iterations, [&]()
+          {
+              auto in = view;
+              std::string value;
+              while (length(in) > 0)
+              {
+                  in = drop(1, in);
+                  value.clear();
+                  while (true)
+                  {
+                      const auto res = character(in);
+                      if (!res)
+                          break;
+                      value.push_back(efp::snd(res.value()));
+                      in = efp::fst(res.value());
+                  }
+                  in = drop(2, in);
+                  do_not_optimize(value);
+              } });
+
+    char buffer[256];
+
+    bench("escaped_string: escaped_string", input.size(), iterations, [&]()
+          {
+              auto in = view;
+              while (length(in) > 0)
+              {
+                  const auto res = escaped_string(in);
+                  const auto value = efp::snd(res.value()).value(buffer);
+                  do_not_optimize(value);
+                  in = drop(1, efp::fst(res.value()));
+              } });
+
+    return 0;
+}
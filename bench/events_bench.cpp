@@ -0,0 +1,81 @@
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+struct Record
+{
+};
+
+// Aggregates on the fly: the number of records and the total of their values
+struct SumSink
+{
+    size_t records = 0;
+    size_t total = 0;
+
+    template <typename A>
+    void value(const A &) {}
+
+    void value(const efp::StringView &s)
+    {
+        total += length(s);
+    }
+
+    void start(Record) {}
+
+    void end(Record)
+    {
+        ++records;
+    }
+};
+
+int main()
+{
+    // Lines of "name = value, value, value;"
+    std::string input;
+    for (size_t i = 0; input.size() < (1 << 24); ++i)
+        input += "metric" + std::to_string(i % 1000) + " = " + std::to_string(i) + ", " + std::to_string(i * 7) + ", " + std::to_string(i * 13) + ";\n";
+
+    const efp::StringView view(input.data(), input.size());
+    const size_t iterations = 10;
+
+    const auto values = tpl(digit1, ch(','), skip_space0, digit1, ch(','), skip_space0, digit1);
+    const auto record = event<Record>(tpl(alphanumeric1, skip_space0, ch('='), skip_space0, values, ch(';'), skip_multispace0));
+
+    bench("events: parse and fold the tuples", input.size(), iterations, [&]()
+          {
+              auto in = view;
+              size_t records = 0;
+              size_t total = 0;
+              while (true)
+              {
+                  const auto res = record(in);
+                  if (!res)
+                      break;
+                  const auto &t = efp::snd(res.value());
+                  const auto &v = efp::p<4>(t);
+                  total += length(efp::p<0>(t)) + length(efp::p<0>(v)) + length(efp::p<3>(v)) + length(efp::p<6>(v));
+                  ++records;
+                  in = efp::fst(res.value());
+              }
+              do_not_optimize(records);
+              do_not_optimize(total); });
+
+    bench("events: parse_events into a sink", input.size(), iterations, [&]()
+          {
+              auto in = view;
+              SumSink sink;
+              while (true)
+              {
+                  const auto res = parse_events(record, in, sink);
+                  if (!res)
+                      break;
+                  in = res.value();
+              }
+              do_not_optimize(sink); });
+
+    return 0;
+}
@@ -0,0 +1,3 @@
+# Prints the size of FILE, as cmake -DFILE=<path> -P file_size.cmake
+file(SIZE ${FILE} size)
+message(STATUS "${FILE}: ${size} bytes")
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    const size_t count = 1 << 18;
+
+    std::vector<std::string> timestamps;
+    std::vector<std::string> addresses;
+    for (size_t i = 0; i < count; ++i)
+    {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "20%02zu-%02zu-%02zuT%02zu:%02zu:%02zu",
+                 i % 100, i % 12 + 1, i % 28 + 1, i % 24, i % 60, (i / 7) % 60);
+        timestamps.push_back(buffer);
+        snprintf(buffer, sizeof(buffer), "%zu.%zu.%zu.%zu", i % 256, (i / 3) % 256, (i / 11) % 256, (i / 101) % 256);
+        addresses.push_back(buffer);
+    }
+
+    size_t timestamp_bytes = 0;
+    for (const auto &s : timestamps)
+        timestamp_bytes += s.size();
+
+    size_t address_bytes = 0;
+    for (const auto &s : addresses)
+        address_bytes += s.size();
+
+    const size_t iterations = 20;
+
+    const auto combinator_timestamp = tpl(digit1, ch('-'), digit1, ch('-'), digit1, ch('T'),
+                                          digit1, ch(':'), digit1, ch(':'), digit1);
+
+    bench("fixed_format: timestamp combinators", timestamp_bytes, iterations, [&]()
+          {
+              size_t matched = 0;
+              for (const auto &s : timestamps)
+                  if (combinator_timestamp(efp::StringView(s.data(), s.size())))
+                      ++matched;
+              do_not_optimize(matched); });
+
+    bench("fixed_format: date_time", timestamp_bytes, iterations, [&]()
+          {
+              size_t matched = 0;
+              for (const auto &s : timestamps)
+                  if (date_time(efp::StringView(s.data(), s.size())))
+                      ++matched;
+              do_not_optimize(matched); });
+
+    const auto combinator_ipv4 = tpl(digit1, ch('.'), digit1, ch('.'), digit1, ch('.'), digit1);
+
+    bench("fixed_format: ipv4 combinators", address_bytes, iterations, [&]()
+          {
+              size_t matched = 0;
+              for (const auto &s : addresses)
+                  if (combinator_ipv4(efp::StringView(s.data(), s.size())))
+                      ++matched;
+              do_not_optimize(matched); });
+
+    bench("fixed_format: ipv4", address_bytes, iterations, [&]()
+          {
+              size_t matched = 0;
+              for (const auto &s : addresses)
+                  if (ipv4(efp::StringView(s.data(), s.size())))
+                      ++matched;
+              do_not_optimize(matched); });
+
+    return 0;
+}
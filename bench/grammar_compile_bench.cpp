@@ -0,0 +1,59 @@
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+// Synthetic grammar with wide alternations and long sequences, to measure the compile time and the object size of
+// the combinators. The build of this target is timed, and the size of the executable reported after it.
+
+using namespace efp::parser;
+
+#define KEYWORDS8(k) tag(k "0"), tag(k "1"), tag(k "2"), tag(k "3"), tag(k "4"), tag(k "5"), tag(k "6"), tag(k "7")
+
+// Statement of 24 parts, with runs of fixed width parsers between the variable width ones
+#define STATEMENT(k)                                                          \
+    tpl(tag(k), ch(' '), alpha1, ch('('), digit1, ch(','), ch(' '), digit1,  \
+        ch(')'), ch(' '), ch('='), ch(' '), alphanumeric1, ch('.'), alpha1,  \
+        ch('['), hex_digit1, ch(']'), space0, one_of("+-"), digit1, ch(';'), \
+        space0, line_ending)
+
+int main()
+{
+    const auto keyword = alt(KEYWORDS8("a"), KEYWORDS8("b"), KEYWORDS8("c"), KEYWORDS8("d"),
+                             KEYWORDS8("e"), KEYWORDS8("f"), KEYWORDS8("g"), KEYWORDS8("h"));
+
+    const auto statement = alt(STATEMENT("let"), STATEMENT("var"), STATEMENT("set"), STATEMENT("put"),
+                               STATEMENT("get"), STATEMENT("add"), STATEMENT("sub"), STATEMENT("mul"),
+                               STATEMENT("div"), STATEMENT("mod"), STATEMENT("and"), STATEMENT("xor"),
+                               STATEMENT("shl"), STATEMENT("shr"), STATEMENT("rol"), STATEMENT("ror"));
+
+    const auto line = alt(map(statement, [](const auto &) { return 1; }),
+                          map(tpl(keyword, line_ending), [](const auto &) { return 0; }));
+
+    const char *statements[] = {"let", "var", "set", "put", "get", "add", "sub", "mul",
+                                "div", "mod", "and", "xor", "shl", "shr", "rol", "ror"};
+
+    std::string input;
+    for (size_t i = 0; input.size() < (1 << 22); ++i)
+    {
+        if (i % 4 == 0)
+            input += std::string(1, static_cast<char>('a' + i % 8)) + std::to_string(i % 8) + "\n";
+        else
+            input += std::string(statements[i % 16]) + " x(" + std::to_string(i) + ", 7) = v" + std::to_string(i % 10) +
+                     ".field[ff] -1;\n";
+    }
+
+    bench("grammar", input.size(), 20, [&]()
+          {
+              efp::StringView rest(input.data(), input.size());
+              size_t statement_count = 0;
+              while (const auto res = line(rest))
+              {
+                  statement_count += snd(res.value());
+                  rest = fst(res.value());
+              }
+              do_not_optimize(statement_count); });
+
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include <cstdlib>
+#include <string>
+
+#include "json_parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+// Generated documents in the shape of the usual corpora
+
+// twitter.json: objects of short strings, ids and nested users
+std::string twitter_like(size_t statuses)
+{
+    std::string s = "{\"statuses\": [";
+    for (size_t i = 0; i < statuses; ++i)
+    {
+        if (i > 0)
+            s += ",";
+        s += "{\"id\": " + std::to_string(505874924095815681 + i) +
+             ", \"text\": \"@aym0566x \\u540d\\u524d: \\\"quoted\\\" status number " + std::to_string(i) + "\"" +
+             ", \"truncated\": false, \"in_reply_to_status_id\": null" +
+             ", \"user\": {\"id\": " + std::to_string(1186275104 + i) +
+             ", \"name\": \"user name\", \"screen_name\": \"screen_name\", \"followers_count\": " + std::to_string(i % 1000) +
+             ", \"verified\": " + (i % 3 == 0 ? "true" : "false") + "}" +
+             ", \"entities\": {\"hashtags\": [], \"urls\": [], \"user_mentions\": [{\"screen_name\": \"aym0566x\", \"indices\": [0, 9]}]}" +
+             ", \"retweet_count\": " + std::to_string(i % 50) + ", \"lang\": \"ja\"}";
+    }
+    return s + "]}";
+}
+
+// canada.json: a long array of coordinate pairs
+std::string canada_like(size_t points)
+{
+    std::string s = "{\"type\": \"Polygon\", \"coordinates\": [[";
+    char buffer[64];
+    for (size_t i = 0; i < points; ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%s[-%.14f,%.14f]", i > 0 ? "," : "", 65.613616999999977 + i * 1e-6, 43.420273000000009 + i * 1e-6);
+        s += buffer;
+    }
+    return s + "]]}";
+}
+
+// Counts the events, as a consumer aggregating on the fly would
+struct CountingHandler
+{
+    size_t events = 0;
+    double sum = 0;
+
+    void null() { ++events; }
+    void boolean(bool) { ++events; }
+    void number(double n)
+    {
+        ++events;
+        sum += n;
+    }
+    void string(const EscapedString &) { ++events; }
+    void key(const EscapedString &) { ++events; }
+    void start_object() { ++events; }
+    void end_object() { ++events; }
+    void start_array() { ++events; }
+    void end_array() { ++events; }
+};
+
+// Hand-written recursive descent parser with the same handler, as the baseline
+class HandWritten
+{
+public:
+    HandWritten(const char *p, size_t n, CountingHandler &handler)
+        : p_(p), end_(p + n), handler_(handler) {}
+
+    bool document()
+    {
+        return value() && (ws(), p_ == end_);
+    }
+
+private:
+    void ws()
+    {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t'))
+            ++p_;
+    }
+
+    bool value()
+    {
+        ws();
+        if (p_ == end_)
+            return false;
+
+        bool ok;
+        switch (*p_)
+        {
+        case '{':
+            ok = object();
+            break;
+        case '[':
+            ok = array();
+            break;
+        case '"':
+            ok = string(false);
+            break;
+        case 't':
+            ok = literal("true", 4);
+            handler_.boolean(true);
+            break;
+        case 'f':
+            ok = literal("false", 5);
+            handler_.boolean(false);
+            break;
+        case 'n':
+            ok = literal("null", 4);
+            handler_.null();
+            break;
+        default:
+            ok = number();
+        }
+
+        ws();
+        return ok;
+    }
+
+    bool literal(const char *s, size_t n)
+    {
+        if (static_cast<size_t>(end_ - p_) < n || memcmp(p_, s, n) != 0)
+            return false;
+        p_ += n;
+        return true;
+    }
+
+    bool string(bool is_key)
+    {
+        const char *begin = ++p_;
+        bool has_escapes = false;
+        while (p_ < end_ && *p_ != '"')
+        {
+            if (*p_ == '\\')
+            {
+                has_escapes = true;
+                ++p_;
+            }
+            ++p_;
+        }
+        if (p_ >= end_)
+            return false;
+
+        const EscapedString s{efp::StringView(begin, p_ - begin), has_escapes};
+        ++p_;
+        if (is_key)
+            handler_.key(s);
+        else
+            handler_.string(s);
+        return true;
+    }
+
+    bool number()
+    {
+        char *number_end;
+        const double n = strtod(p_, &number_end);
+        if (number_end == p_)
+            return false;
+        p_ = number_end;
+        handler_.number(n);
+        return true;
+    }
+
+    bool array()
+    {
+        ++p_;
+        handler_.start_array();
+        ws();
+        if (p_ < end_ && *p_ == ']')
+        {
+            ++p_;
+            handler_.end_array();
+            return true;
+        }
+        while (true)
+        {
+            if (!value() || p_ == end_)
+                return false;
+            if (*p_ == ']')
+            {
+                ++p_;
+                handler_.end_array();
+                return true;
+            }
+            if (*p_++ != ',')
+                return false;
+        }
+    }
+
+    bool object()
+    {
+        ++p_;
+        handler_.start_object();
+        ws();
+        if (p_ < end_ && *p_ == '}')
+        {
+            ++p_;
+            handler_.end_object();
+            return true;
+        }
+        while (true)
+        {
+            ws();
+            if (p_ == end_ || *p_ != '"' || !string(true))
+                return false;
+            ws();
+            if (p_ == end_ || *p_++ != ':')
+                return false;
+            if (!value() || p_ == end_)
+                return false;
+            if (*p_ == '}')
+            {
+                ++p_;
+                handler_.end_object();
+                return true;
+            }
+            if (*p_++ != ',')
+                return false;
+        }
+    }
+
+    const char *p_;
+    const char *end_;
+    CountingHandler &handler_;
+};
+
+void run(const char *corpus, const std::string &document)
+{
+    const efp::StringView in(document.data(), document.size());
+    const size_t iterations = 10;
+
+    printf("%s (%zu bytes)\n", corpus, document.size());
+
+    bench("json: hand-written baseline", document.size(), iterations, [&]()
+          {
+              CountingHandler handler;
+              HandWritten(document.data(), document.size(), handler).document();
+              do_not_optimize(handler); });
+
+    bench("json: json_sax", document.size(), iterations, [&]()
+          {
+              CountingHandler handler;
+              json_sax(in, handler);
+              do_not_optimize(handler); });
+
+    bench("json: json_dom", document.size(), iterations, [&]()
+          {
+              JsonArena arena;
+              const auto root = json_dom(in, arena);
+              do_not_optimize(root); });
+}
+
+int main()
+{
+    run("twitter-like", twitter_like(20000));
+    run("canada-like", canada_like(200000));
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    std::string text;
+    while (text.size() < (1 << 20))
+        text += "if x12 = (345 + foo_bar) * bar9 / 7 - qux;\n";
+
+    const efp::StringView in(text.data(), text.size());
+    const size_t iterations = 50;
+
+    // DFA lexer
+    const auto lex = lexer(tag("if"), tpl(alpha1, alphanumeric0), digit1, one_of("+-*/=();_"), multispace1);
+    std::vector<Lexeme<efp::StringView>> tokens;
+    tokens.reserve(text.size());
+
+    bench("lexer: DFA", text.size(), iterations, [&]()
+          {
+              tokens.clear();
+              const auto rest = lex.tokenize(in, tokens);
+              do_not_optimize(rest);
+              do_not_optimize(tokens.back()); });
+
+    printf("%-40s %8zu tokens\n", "", tokens.size());
+
+    // Equivalent alternation of the same definitions, first match instead of the longest
+    const auto grammar = alt(skip(tag("if")),
+                             skip(tpl(alpha1, alphanumeric0)),
+                             skip(digit1),
+                             skip(one_of("+-*/=();_")),
+                             skip(multispace1));
+    size_t count = 0;
+
+    bench("lexer: AltParser", text.size(), iterations, [&]()
+          {
+              count = 0;
+              efp::StringView rest = in;
+              while (!rest.empty())
+              {
+                  const auto res = grammar(rest);
+                  if (!res)
+                      break;
+                  rest = fst(res.value());
+                  ++count;
+              }
+              do_not_optimize(rest); });
+
+    printf("%-40s %8zu tokens\n", "", count);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    const size_t max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+    // Log lines of a timestamp, a level, a metric and a list of values of varying length
+    std::string log;
+    for (size_t i = 0; log.size() < (1 << 24); ++i)
+    {
+        log += std::to_string(1700000000 + i) + " " + (i % 5 == 0 ? "warn" : "info") + " metric" +
+               std::to_string(i % 97) + ":";
+        for (size_t k = 0; k < 1 + i % 9; ++k)
+            log += " " + std::to_string(i * 7919 % (10 + k * 1000));
+        log += "\n";
+    }
+
+    const efp::StringView in(log.data(), log.size());
+    const auto line = tpl(parse_uint64, ch(' '), alpha1, ch(' '), alphanumeric1, ch(':'), ch(' '),
+                          separated0(ch(' '), parse_uint32));
+    const size_t iterations = 5;
+
+    bench("parallel: serial loop", log.size(), iterations, [&]()
+          {
+              std::vector<CallParserO<decltype(line), efp::StringView>> outputs;
+              efp::StringView rest = in;
+              while (true)
+              {
+                  const auto res = line(rest);
+                  if (!res)
+                      break;
+                  outputs.push_back(snd(res.value()));
+
+                  const auto res_sep = line_ending(fst(res.value()));
+                  if (!res_sep)
+                      break;
+                  rest = fst(res_sep.value());
+              }
+              do_not_optimize(outputs); });
+
+    for (size_t n = 1; n <= max_threads; n *= 2)
+    {
+        const auto lines = parallel_separated(line_ending, not_line_ending, line, n);
+
+        char name[64];
+        snprintf(name, sizeof(name), "parallel: %zu threads", n);
+        bench(name, log.size(), iterations, [&]()
+              {
+                  const auto res = lines(in);
+                  do_not_optimize(res); });
+    }
+
+    return 0;
+}
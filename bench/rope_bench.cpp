@@ -0,0 +1,60 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+template <typename In, typename P>
+size_t parse_records(In in, const P &record)
+{
+    size_t sum = 0;
+    while (length(in) > 0)
+    {
+        const auto res = record(in);
+        if (!res)
+            break;
+        sum += efp::p<2>(snd(res.value()));
+        in = fst(res.value());
+    }
+    return sum;
+}
+
+int main()
+{
+    // A message of key=value records, as it arrives in packets of 1448 bytes
+    std::string message;
+    for (size_t i = 0; message.size() < (1 << 22); ++i)
+        message += "field" + std::string(1, static_cast<char>('a' + i % 26)) + "=" + std::to_string(i * 7919 % 100000) + ";";
+
+    std::vector<std::string> packets;
+    for (size_t i = 0; i < message.size(); i += 1448)
+        packets.push_back(message.substr(i, 1448));
+
+    std::vector<efp::StringView> segments;
+    for (const auto &p : packets)
+        segments.push_back(efp::StringView(p.data(), p.size()));
+
+    const auto record = tpl(alpha1, ch('='), parse_uint32, ch(';'));
+    const size_t iterations = 20;
+
+    std::string gathered(message.size(), ' ');
+
+    bench("rope: copy into a buffer, then parse", message.size(), iterations, [&]()
+          {
+              char *out = &gathered[0];
+              for (const auto &s : segments)
+              {
+                  std::memcpy(out, s.data(), length(s));
+                  out += length(s);
+              }
+              do_not_optimize(parse_records(efp::StringView(gathered.data(), gathered.size()), record)); });
+
+    bench("rope: parse the segments", message.size(), iterations, [&]()
+          { do_not_optimize(parse_records(Rope(segments.data(), segments.size()), record)); });
+
+    return 0;
+}
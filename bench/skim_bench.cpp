@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <string>
+
+#include "parser.hpp"
+#include "json_parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+struct Reading
+{
+    uint64_t id;
+    size_t sensor;
+    uint32_t count;
+    int32_t delta;
+};
+
+template <typename P>
+void bench_records(const char *name, const std::string &input, const P &p)
+{
+    bench(name, input.size(), 20, [&]()
+          {
+              efp::StringView in(input.data(), input.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = p(in);
+                  if (!res)
+                      break;
+                  sum += snd(res.value()).count;
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+}
+
+template <typename P>
+void bench_skim(const char *name, const std::string &input, const P &p)
+{
+    bench(name, input.size(), 20, [&]()
+          {
+              efp::StringView in(input.data(), input.size());
+              size_t matched = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = skim(p, in);
+                  if (!res)
+                      break;
+                  ++matched;
+                  in = res.value();
+              }
+              do_not_optimize(matched); });
+}
+
+int main()
+{
+    // Records of an id, a sensor name, a count and a signed delta
+    std::string records;
+    for (size_t i = 0; records.size() < (1 << 22); ++i)
+        records += std::to_string(1000000 + i) + ",sensor" + std::string(1, static_cast<char>('a' + i % 26)) + "," +
+                   std::to_string(i * 7919 % 100000) + "," + std::to_string(static_cast<int>(i % 2001) - 1000) + "\n";
+
+    const auto record = map(tpl(parse_uint64, ch(','), alphanumeric1, ch(','), parse_uint32, ch(','), parse_int32, ch('\n')),
+                            [](const efp::Tuple<uint64_t, char, efp::StringView, char, uint32_t, char, int32_t, char> &t)
+                            { return Reading{efp::p<0>(t), length(efp::p<2>(t)), efp::p<4>(t), efp::p<6>(t)}; });
+
+    bench_records("skim: records, parsed", records, record);
+    bench_skim("skim: records, skimmed", records, record);
+
+    // Rows of JSON numbers
+    std::string numbers;
+    char buffer[64];
+    for (size_t i = 0; numbers.size() < (1 << 22); ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%s%.6f", i % 16 == 0 ? "\n" : ",", (i * 7919 % 100000) * 1.37e-3 - 50);
+        numbers += buffer;
+    }
+
+    const auto row = preceded(ch('\n'), separated0(ch(','), json_number));
+
+    bench("skim: numbers, parsed", numbers.size(), 20, [&]()
+          {
+              efp::StringView in(numbers.data(), numbers.size());
+              size_t rows = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = row(in);
+                  if (!res)
+                      break;
+                  rows += snd(res.value());
+                  in = fst(res.value());
+              }
+              do_not_optimize(rows); });
+
+    bench_skim("skim: numbers, skimmed", numbers, row);
+
+    return 0;
+}
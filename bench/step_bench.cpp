@@ -0,0 +1,179 @@
+#include <cstdint>
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+// Calls which are not inlined, to compare how the results are returned
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __declspec(noinline)
+#endif
+
+BENCH_NOINLINE Parsed<efp::StringView, efp::StringView> call_alpha1(const efp::StringView &in)
+{
+    return alpha1(in);
+}
+
+BENCH_NOINLINE Step<Matched> step_alpha1(const char *begin, const char *end)
+{
+    return alpha1.parse_step(begin, end);
+}
+
+BENCH_NOINLINE Parsed<efp::StringView, uint32_t> call_uint32(const efp::StringView &in)
+{
+    return parse_uint32(in);
+}
+
+BENCH_NOINLINE Step<uint32_t> step_uint32(const char *begin, const char *end)
+{
+    return parse_uint32.parse_step(begin, end);
+}
+
+template <typename P>
+void bench_records(const char *name, const std::string &input, const P &p)
+{
+    bench(name, input.size(), 20, [&]()
+          {
+              efp::StringView in(input.data(), input.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = p(in);
+                  if (!res)
+                      break;
+                  sum += efp::p<4>(snd(res.value()));
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+}
+
+int main()
+{
+    // Words and numbers separated by single spaces
+    std::string words;
+    std::string numbers;
+    for (size_t i = 0; words.size() < (1 << 22); ++i)
+    {
+        words += std::string(1 + i % 11, static_cast<char>('a' + i % 26)) + " ";
+        numbers += std::to_string(i * 7919 % 1000000) + " ";
+    }
+
+    bench("step: alpha1 call, Parsed", words.size(), 20, [&]()
+          {
+              efp::StringView in(words.data(), words.size());
+              size_t matched = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = call_alpha1(in);
+                  if (!res)
+                      break;
+                  matched += length(snd(res.value()));
+                  in = drop(1, fst(res.value()));
+              }
+              do_not_optimize(matched); });
+
+    bench("step: alpha1 call, Step", words.size(), 20, [&]()
+          {
+              const char *p = words.data();
+              const char *end = p + words.size();
+              size_t matched = 0;
+              while (p != end)
+              {
+                  const auto res = step_alpha1(p, end);
+                  if (!res)
+                      break;
+                  matched += static_cast<size_t>(res.end - p);
+                  p = res.end + 1;
+              }
+              do_not_optimize(matched); });
+
+    bench("step: uint32 call, Parsed", numbers.size(), 20, [&]()
+          {
+              efp::StringView in(numbers.data(), numbers.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = call_uint32(in);
+                  if (!res)
+                      break;
+                  sum += snd(res.value());
+                  in = drop(1, fst(res.value()));
+              }
+              do_not_optimize(sum); });
+
+    bench("step: uint32 call, Step", numbers.size(), 20, [&]()
+          {
+              const char *p = numbers.data();
+              const char *end = p + numbers.size();
+              uint64_t sum = 0;
+              while (p != end)
+              {
+                  const auto res = step_uint32(p, end);
+                  if (!res)
+                      break;
+                  sum += res.output;
+                  p = res.end + 1;
+              }
+              do_not_optimize(sum); });
+
+    // Records of an id, a sensor name, a count, a signed delta and a hexadecimal checksum
+    std::string records;
+    char buffer[128];
+    for (size_t i = 0; records.size() < (1 << 22); ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%zu,sensor%c,%zu,%d,%zx\n", 1000000 + i, static_cast<char>('a' + i % 26),
+                 i * 7919 % 100000, static_cast<int>(i % 2001) - 1000, i * 2654435761u % 65536);
+        records += buffer;
+    }
+
+    const auto record = tpl(parse_uint64, ch(','), alphanumeric1, ch(','), parse_uint32, ch(','), parse_int32, ch(','),
+                            hex_digit1, line_ending);
+
+    bench_records("step: records, StringView", records, record);
+
+    bench("step: records, Cursor", records.size(), 20, [&]()
+          {
+              Cursor in(efp::StringView(records.data(), records.size()));
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = record(in);
+                  if (!res)
+                      break;
+                  sum += efp::p<4>(snd(res.value()));
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+
+    // Log lines of a level, a timestamp, a source and a message, mostly runs of characters
+    std::string lines;
+    for (size_t i = 0; lines.size() < (1 << 22); ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%s %zu %s:%zu request handled in time\n", i % 3 ? "INFO" : "WARN",
+                 1700000000 + i, i % 2 ? "server" : "worker", i % 64);
+        lines += buffer;
+    }
+
+    const auto line = tpl(alpha1, space1, digit1, space1, alpha1, ch(':'), digit1, space1, not_line_ending, line_ending);
+
+    bench("step: log lines, StringView", lines.size(), 20, [&]()
+          {
+              efp::StringView in(lines.data(), lines.size());
+              size_t matched = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = line(in);
+                  if (!res)
+                      break;
+                  matched += length(efp::p<8>(snd(res.value())));
+                  in = fst(res.value());
+              }
+              do_not_optimize(matched); });
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    // Lines of a metric and a value, as a line protocol over a socket
+    std::string lines;
+    for (size_t i = 0; lines.size() < (1 << 22); ++i)
+        lines += "metric" + std::to_string(i % 97) + " " + std::to_string(i * 7919 % 100000) + "\n";
+
+    const auto metric = tpl(alphanumeric1, ch(' '), parse_uint32);
+    const size_t iterations = 20;
+
+    bench("stream: whole buffer", lines.size(), iterations, [&]()
+          {
+              efp::StringView in(lines.data(), lines.size());
+              uint64_t sum = 0;
+              while (length(in) > 0)
+              {
+                  const auto res = terminated(metric, ch('\n'))(in);
+                  if (!res)
+                      break;
+                  sum += efp::p<2>(snd(res.value()));
+                  in = fst(res.value());
+              }
+              do_not_optimize(sum); });
+
+    // Reads of the size of a typical packet, and of a small buffer
+    const size_t read_sizes[] = {1460, 64};
+    for (const size_t read_size : read_sizes)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "stream: reads of %zu bytes", read_size);
+        bench(name, lines.size(), iterations, [&]()
+              {
+                  MessageStream<DelimiterFramer> stream(delimiter_framer("\n"));
+                  uint64_t sum = 0;
+                  for (size_t i = 0; i < lines.size(); i += read_size)
+                  {
+                      stream.feed(lines.data() + i, std::min(read_size, lines.size() - i));
+                      while (true)
+                      {
+                          const auto msg = stream.poll(metric);
+                          if (!msg)
+                              break;
+                          sum += efp::p<2>(msg.value());
+                      }
+                  }
+                  do_not_optimize(sum); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+#if __cplusplus >= 202002L
+
+template <typename P>
+void bench_lines(const char *name, const std::vector<std::string> &lines, size_t bytes, const P &p)
+{
+    bench(name, bytes, 50, [&]()
+          {
+              size_t matched = 0;
+              for (const auto &s : lines)
+                  if (p(efp::StringView(s.data(), s.size())))
+                      ++matched;
+              do_not_optimize(matched); });
+}
+
+int main()
+{
+    const size_t count = 1 << 18;
+
+    const char *methods[] = {"GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS"};
+    const char *headers[] = {"Host", "User-Agent", "Accept", "Accept-Encoding", "Content-Length", "Content-Type",
+                             "Connection"};
+
+    std::vector<std::string> request_lines;
+    std::vector<std::string> header_lines;
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Mostly GET, as in a typical log
+        request_lines.push_back(std::string(methods[i % 4 == 0 ? i / 4 % 7 : 0]) + " /index.html HTTP/1.1");
+        header_lines.push_back(std::string(headers[i % 7]) + ": value");
+    }
+
+    size_t request_bytes = 0;
+    for (const auto &s : request_lines)
+        request_bytes += s.size();
+
+    size_t header_bytes = 0;
+    for (const auto &s : header_lines)
+        header_bytes += s.size();
+
+    bench_lines("tag: methods, runtime tags", request_lines, request_bytes,
+                alt(tag("GET"), tag("HEAD"), tag("POST"), tag("PUT"), tag("PATCH"), tag("DELETE"), tag("OPTIONS")));
+
+    bench_lines("tag: methods, literal tags", request_lines, request_bytes,
+                alt(tag<"GET">(), tag<"HEAD">(), tag<"POST">(), tag<"PUT">(), tag<"PATCH">(), tag<"DELETE">(),
+                    tag<"OPTIONS">()));
+
+    bench_lines("tag: headers, runtime tags", header_lines, header_bytes,
+                alt(tag("Host"), tag("User-Agent"), tag("Accept-Encoding"), tag("Accept"), tag("Content-Length"),
+                    tag("Content-Type"), tag("Connection")));
+
+    bench_lines("tag: headers, literal tags", header_lines, header_bytes,
+                alt(tag<"Host">(), tag<"User-Agent">(), tag<"Accept-Encoding">(), tag<"Accept">(),
+                    tag<"Content-Length">(), tag<"Content-Type">(), tag<"Connection">()));
+
+    return 0;
+}
+
+#else
+
+int main()
+{
+    printf("tag: literal tags need C++20, skipped\n");
+    return 0;
+}
+
+#endif
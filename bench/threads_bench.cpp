@@ -0,0 +1,79 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+// Result of a thread on its own cache line, so that the threads never write to a shared line
+struct alignas(64) Slot
+{
+    size_t sum;
+};
+
+template <typename P>
+size_t parse_records(const std::string &input, const P &record)
+{
+    efp::StringView in(input.data(), input.size());
+    size_t sum = 0;
+    while (length(in) > 0)
+    {
+        const auto res = record(in);
+        if (!res)
+            break;
+        sum += efp::p<2>(snd(res.value()));
+        in = fst(res.value());
+    }
+    return sum;
+}
+
+int main()
+{
+    const size_t max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+    std::string input;
+    for (size_t i = 0; input.size() < (1 << 22); ++i)
+        input += "field" + std::string(1, static_cast<char>('a' + i % 26)) + (i % 2 ? "=" : ":") +
+                 std::to_string(i * 7919 % 100000) + ";";
+
+    // One grammar shared by all the threads
+    const auto record = tpl(alpha1, one_of("=:"), parse_uint32, ch(';'));
+    const size_t iterations = 10;
+
+    for (size_t n = 1; n <= max_threads; n *= 2)
+    {
+        // Each thread parses its own copy of the input
+        std::vector<std::string> inputs(n, input);
+        std::vector<Slot> slots(n);
+
+        char name[64];
+        snprintf(name, sizeof(name), "threads: %zu, shared grammar", n);
+        bench(name, input.size() * n, iterations, [&]()
+              {
+                  std::vector<std::thread> threads;
+                  for (size_t t = 0; t < n; ++t)
+                      threads.emplace_back([&, t]()
+                                           { slots[t].sum = parse_records(inputs[t], record); });
+                  for (auto &t : threads)
+                      t.join();
+                  do_not_optimize(slots); });
+
+        snprintf(name, sizeof(name), "threads: %zu, a copy of the grammar each", n);
+        bench(name, input.size() * n, iterations, [&]()
+              {
+                  std::vector<std::thread> threads;
+                  for (size_t t = 0; t < n; ++t)
+                      threads.emplace_back([&, t]()
+                                           {
+                                               const auto copy = record;
+                                               slots[t].sum = parse_records(inputs[t], copy); });
+                  for (auto &t : threads)
+                      t.join();
+                  do_not_optimize(slots); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <string>
+
+#include "parser.hpp"
+
+#include "bench_common.hpp"
+
+using namespace efp::parser;
+
+int main()
+{
+    // Identifiers separated by spaces, mostly ASCII as in typical inputs
+    std::string ascii;
+    std::string mixed;
+    for (size_t i = 0; ascii.size() < (1 << 24); ++i)
+    {
+        ascii += "identifier" + std::to_string(i % 100) + " ";
+        mixed += (i % 100 == 0 ? "caf\xC3\xA9" : "identifier") + std::to_string(i % 100) + " ";
+    }
+
+    const efp::StringView ascii_view(ascii.data(), ascii.size());
+    const efp::StringView mixed_view(mixed.data(), mixed.size());
+    const size_t iterations = 20;
+
+    bench("unicode: utf8_valid ascii", ascii.size(), iterations, [&]()
+          { do_not_optimize(utf8_valid(ascii_view)); });
+
+    bench("unicode: utf8_valid mixed", mixed.size(), iterations, [&]()
+          { do_not_optimize(utf8_valid(mixed_view)); });
+
+    bench("unicode: alphanumeric1 ascii", ascii.size(), iterations, [&]()
+          {
+              auto in = ascii_view;
+              while (length(in) > 0)
+              {
+                  const auto res = alphanumeric1(in);
+                  in = drop(res ? length(efp::snd(res.value())) + 1 : 1, in);
+              }
+              do_not_optimize(in); });
+
+    bench("unicode: utf8_alphanumeric1 ascii", ascii.size(), iterations, [&]()
+          {
+              auto in = ascii_view;
+              while (length(in) > 0)
+              {
+                  const auto res = utf8_alphanumeric1(in);
+                  in = drop(res ? length(efp::snd(res.value())) + 1 : 1, in);
+              }
+              do_not_optimize(in); });
+
+    bench("unicode: utf8_alphanumeric1 mixed", mixed.size(), iterations, [&]()
+          {
+              auto in = mixed_view;
+              while (length(in) > 0)
+              {
+                  const auto res = utf8_alphanumeric1(in);
+                  in = drop(res ? length(efp::snd(res.value())) + 1 : 1, in);
+              }
+              do_not_optimize(in); });
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+#ifndef EFP_BATCH_HPP_
+#define EFP_BATCH_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "parser_base.hpp"
+#include "token_parser.hpp"
+
+// parse_batch: Runs one parser over many independent inputs, writing into a preallocated BatchResults.
+// The parser is constructed once by the caller, and each input is a single call in a tight loop.
+// With a non-zero prefetch distance, the data of the later inputs are prefetched to hide the memory latency.
+
+namespace efp
+{
+    namespace parser
+    {
+        // BatchResults
+        // Structure of arrays of the results. Allocated once and reused over the batches, and only grown by a batch of
+        // more inputs than the capacity.
+
+        template <typename In, typename Out>
+        class BatchResults
+        {
+        public:
+            explicit BatchResults(size_t capacity)
+                : size_(0), matched_(capacity), rests_(capacity), outputs_(capacity) {}
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            size_t capacity() const
+            {
+                return matched_.size();
+            }
+
+            bool matched(size_t i) const
+            {
+                return matched_[i] != 0;
+            }
+
+            // Remaining input, valid only if matched. Otherwise it is stale, of an earlier batch or default constructed.
+            const In &rest(size_t i) const
+            {
+                return rests_[i];
+            }
+
+            // Output, valid only if matched. Otherwise it is stale, as the remaining input.
+            const Out &output(size_t i) const
+            {
+                return outputs_[i];
+            }
+
+            const uint8_t *matched_data() const
+            {
+                return matched_.data();
+            }
+
+            const In *rests_data() const
+            {
+                return rests_.data();
+            }
+
+            const Out *outputs_data() const
+            {
+                return outputs_.data();
+            }
+
+            // Parses each of the inputs into the arrays, and returns the number of the matched ones
+            template <size_t prefetch_distance, typename P>
+            size_t run(const P &p, const Span<In> &inputs)
+            {
+                const size_t n = length(inputs);
+                size_t matched_count = 0;
+
+                if (n > capacity())
+                {
+                    matched_.resize(n);
+                    rests_.resize(n);
+                    outputs_.resize(n);
+                }
+
+                uint8_t *matched = matched_.data();
+                In *rests = rests_.data();
+                Out *outputs = outputs_.data();
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (prefetch_distance > 0 && i + prefetch_distance < n)
+                        prefetch(inputs[i + prefetch_distance]);
+
+                    const auto res = p(inputs[i]);
+
+                    matched[i] = res ? 1 : 0;
+                    if (res)
+                    {
+                        rests[i] = fst(res.value());
+                        outputs[i] = snd(res.value());
+                        ++matched_count;
+                    }
+                }
+
+                size_ = n;
+                return matched_count;
+            }
+
+        private:
+            static void prefetch(const In &in)
+            {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(in.data());
+#else
+                (void)in;
+#endif
+            }
+
+            size_t size_;
+            std::vector<uint8_t> matched_;
+            std::vector<In> rests_;
+            std::vector<Out> outputs_;
+        };
+
+        // Returns the number of the matched inputs.
+        // The results grow to the number of the inputs if they outnumber its capacity.
+        template <size_t prefetch_distance = 0, typename P, typename In, typename Out>
+        size_t parse_batch(const P &p, const Span<In> &inputs, BatchResults<In, Out> &results)
+        {
+            static_assert(std::is_same<Out, CallParserO<P, In>>::value, "Output type of the results does not match the parser.");
+
+            return results.template run<prefetch_distance>(p, inputs);
+        }
+    }
+}
+
+#endif
@@ -1,49 +1,745 @@
 #ifndef EFP_BYTE_PARSER_HPP
 #define EFP_BYTE_PARSER_HPP
 
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace efp
 {
     namespace parser
     {
+        // Tag over a sequence of arbitrary elements, such as a Span of tokens.
+        // Elements are compared by element_eq, so Enum tokens are compared by their alternative only.
         template <typename In>
-        struct Tag
+        struct Tag : ParserBase<Tag<In>>
         {
             In t;
 
-            auto operator()(const In &in) const
-                -> Parsed<In, In>
+            constexpr explicit Tag(const In &t)
+                : t(t) {}
+
+            template <typename I>
+            constexpr auto parse(const I &in) const
+                -> Parsed<I, I>
             {
-                if (start_with(in, t))
-                    return tuple(drop(length(t), in), t);
-                else
+                const auto t_length = length(t);
+
+                if (length(in) < t_length)
                     return nothing;
+
+                for (size_t i = 0; i < t_length; ++i)
+                {
+                    if (!element_eq(in[i], t[i]))
+                        return nothing;
+                }
+
+                return tuple(drop(t_length, in), take(t_length, in));
             }
         };
 
         template <>
-        struct Tag<StringView>
+        struct Tag<StringView> : ParserBase<Tag<StringView>>
         {
             StringView t;
 
-            auto operator()(const StringView &in) const
-                -> Parsed<StringView, StringView>
+            constexpr explicit Tag(const StringView &t)
+                : t(t) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, StringView>
             {
                 if (start_with(in, t))
                     return tuple(drop(length(t), in), t);
                 else
                     return nothing;
             }
+
+            // Incomplete while the input is a part of t
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, StringView>
+            {
+                for (size_t i = 0; i < length(in) && i < length(t); ++i)
+                {
+                    if (in[i] != t[i])
+                        return detail::partial_decided<In, StringView>(nothing);
+                }
+
+                if (length(in) < length(t))
+                    return detail::partial_incomplete<In, StringView>();
+                return detail::partial_decided(parse(in));
+            }
+
+            constexpr size_t width() const
+            {
+                return length(t);
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                bool res = true;
+                for (size_t i = 0; i < length(t); ++i)
+                    res &= in[i] == t[i];
+                return res;
+            }
+
+            template <typename In>
+            constexpr StringView output(const In &) const
+            {
+                return t;
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<Tag<StringView>> : std::true_type
+        {
+        };
+
+        template <typename In>
+        constexpr Tag<In> tag(const In &t)
+        {
+            return Tag<In>(t);
+        }
+
+        constexpr Tag<StringView> tag(const StringView &t)
+        {
+            return Tag<StringView>(t);
+        }
+
+        // String literals are tags on StringView
+        constexpr Tag<StringView> tag(const char *t)
+        {
+            return Tag<StringView>(StringView(t));
+        }
+
+#if __cplusplus >= 202002L
+        // Literal
+        // String literal as a non-type template parameter, without its terminating null
+
+        template <size_t n>
+        struct Literal
+        {
+            char chars[n + 1] = {};
+
+            constexpr Literal(const char (&s)[n + 1])
+            {
+                for (size_t i = 0; i <= n; ++i)
+                    chars[i] = s[i];
+            }
+
+            static constexpr size_t size()
+            {
+                return n;
+            }
         };
 
-        // template <typename In>
-        // Tag<In> tag(const In &t)
-        // {
-        //     return Tag<In>{t};
-        // }
+        template <size_t m>
+        Literal(const char (&)[m]) -> Literal<m - 1>;
+
+        namespace detail
+        {
+            template <size_t width>
+            using WordOf = typename std::conditional<width == 8, uint64_t,
+                                                     typename std::conditional<width == 4, uint32_t, uint16_t>::type>::type;
+
+            template <size_t width>
+            inline WordOf<width> load_word(const char *p)
+            {
+                WordOf<width> word;
+                std::memcpy(&word, p, width);
+                return word;
+            }
+
+            // Compares n bytes by the widest words which fit, the last one overlapping the previous ones.
+            // q is a literal, so its words are folded into immediates.
+            template <size_t n>
+            inline bool equal_bytes(const char *p, const char *q)
+            {
+                if constexpr (n == 0)
+                {
+                    return true;
+                }
+                else if constexpr (n == 1)
+                {
+                    return p[0] == q[0];
+                }
+                else
+                {
+                    constexpr size_t width = n >= 8 ? 8 : n >= 4 ? 4 : 2;
+
+                    WordOf<width> diff = 0;
+                    for (size_t i = 0; i + width < n; i += width)
+                        diff |= load_word<width>(p + i) ^ load_word<width>(q + i);
+                    diff |= load_word<width>(p + n - width) ^ load_word<width>(q + n - width);
+                    return diff == 0;
+                }
+            }
+        }
+
+        // LiteralTag
+        // Tag whose literal is part of the type, e.g. tag<"GET">().
+        // Contiguous inputs are compared a word at a time against immediates, and others by an unrolled comparison.
+        // The literal is known to the combinators at compile time, so AltParser could dispatch on its first byte.
+
+        template <Literal lit>
+        struct LiteralTag : ParserBase<LiteralTag<lit>>
+        {
+            static constexpr StringView literal()
+            {
+                return StringView(lit.chars, lit.size());
+            }
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, StringView>
+            {
+                if (length(in) >= lit.size() && matches(in))
+                    return tuple(drop(lit.size(), in), literal());
+                else
+                    return nothing;
+            }
+
+            constexpr size_t width() const
+            {
+                return lit.size();
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                if constexpr (requires { in.data(); })
+                {
+                    if (!std::is_constant_evaluated())
+                        return detail::equal_bytes<lit.size()>(in.data(), lit.chars);
+                }
+
+                return matches_unrolled(in, std::make_index_sequence<lit.size()>{});
+            }
+
+            template <typename In, size_t... is>
+            constexpr bool matches_unrolled(const In &in, std::index_sequence<is...>) const
+            {
+                return ((in[is] == lit.chars[is]) & ... & true);
+            }
+
+            template <typename In>
+            constexpr StringView output(const In &) const
+            {
+                return literal();
+            }
+        };
+
+        template <Literal lit>
+        struct IsFixedWidth<LiteralTag<lit>> : std::true_type
+        {
+        };
+
+        template <Literal lit>
+        struct FirstByte<LiteralTag<lit>>
+        {
+            static constexpr bool known = lit.size() > 0;
+            static constexpr char value = lit.chars[0];
+        };
+
+        template <Literal lit>
+        constexpr LiteralTag<lit> tag()
+        {
+            return LiteralTag<lit>{};
+        }
+#endif
+
+        // Binary formats
+        // be_u16, le_u32, be_f64 and friends: Fixed width numbers in the given byte order, by a single unaligned load.
+        // varint_u32, varint_u64: Unsigned LEB128, as the varints of protobuf. varint_s32 and varint_s64 are zigzag encoded.
+        // length_data(p): Slice of the length parsed by p, as a view of the input.
+        // The input must expose contiguous data(), e.g. StringView or Cursor.
+
+        namespace detail
+        {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            constexpr bool host_big_endian = true;
+#else
+            constexpr bool host_big_endian = false;
+#endif
+
+            inline uint8_t byte_swap(uint8_t v)
+            {
+                return v;
+            }
+
+            inline uint16_t byte_swap(uint16_t v)
+            {
+                return __builtin_bswap16(v);
+            }
+
+            inline uint32_t byte_swap(uint32_t v)
+            {
+                return __builtin_bswap32(v);
+            }
+
+            inline uint64_t byte_swap(uint64_t v)
+            {
+                return __builtin_bswap64(v);
+            }
+
+            template <size_t size>
+            using UintOf = typename std::conditional<
+                size == 1, uint8_t,
+                typename std::conditional<size == 2, uint16_t,
+                                          typename std::conditional<size == 4, uint32_t, uint64_t>::type>::type>::type;
+
+            // Number T stored in the given byte order at p
+            template <typename T, bool big_endian>
+            inline T load_number(const char *p)
+            {
+                UintOf<sizeof(T)> bits;
+                std::memcpy(&bits, p, sizeof(T));
+
+                if (big_endian != host_big_endian)
+                    bits = byte_swap(bits);
+
+                T value;
+                std::memcpy(&value, &bits, sizeof(T));
+                return value;
+            }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            // Up to 8 bytes of a varint in a little-endian word, the first byte in the lowest byte
+            constexpr bool swar_varint = true;
+#else
+            constexpr bool swar_varint = false;
+#endif
+
+            // Packs the low 7 bits of each byte of the word
+            inline uint64_t pack_varint_payload(uint64_t word)
+            {
+#if defined(__BMI2__)
+                return _pext_u64(word, 0x7F7F7F7F7F7F7F7F);
+#else
+                word &= 0x7F7F7F7F7F7F7F7F;
+                word = ((word & 0x7F007F007F007F00) >> 1) | (word & 0x007F007F007F007F);
+                word = ((word & 0x3FFF00003FFF0000) >> 2) | (word & 0x00003FFF00003FFF);
+                return ((word & 0x0FFFFFFF00000000) >> 4) | (word & 0x000000000FFFFFFF);
+#endif
+            }
+
+            // Decodes an unsigned varint of type T at p.
+            // Returns its length in bytes, or 0 if it is truncated, longer than T allows or out of range.
+            template <typename T>
+            inline size_t decode_varint(const char *p, size_t size, T &value)
+            {
+                constexpr size_t bits = sizeof(T) * 8;
+                constexpr size_t max_length = (bits + 6) / 7;
+
+                // Single byte varints are the most common, as field tags and small lengths
+                if (size > 0 && !(p[0] & 0x80))
+                {
+                    value = static_cast<T>(static_cast<unsigned char>(p[0]));
+                    return 1;
+                }
+
+                // Varints which end in the first 8 bytes take a single load, and no loop
+                if (swar_varint && size >= 8)
+                {
+                    uint64_t word;
+                    std::memcpy(&word, p, 8);
+
+                    const uint64_t ends = ~word & 0x8080808080808080;
+                    if (ends != 0)
+                    {
+                        const auto n = static_cast<size_t>(__builtin_ctzll(ends)) / 8 + 1;
+
+                        // Keeps the bytes up to and including the last one
+                        const uint64_t v = pack_varint_payload(word & (ends ^ (ends - 1)));
+                        if (bits < 64 && (n > max_length || (v >> (bits % 64)) != 0))
+                            return 0;
+
+                        value = static_cast<T>(v);
+                        return n;
+                    }
+                }
+
+                uint64_t v = 0;
+                for (size_t i = 0; i < max_length && i < size; ++i)
+                {
+                    const auto b = static_cast<unsigned char>(p[i]);
+
+                    // The last byte holds only the bits left
+                    if (i == max_length - 1 && (b >> (bits - 7 * i)) != 0)
+                        return 0;
+
+                    v |= static_cast<uint64_t>(b & 0x7F) << (7 * i);
+                    if (!(b & 0x80))
+                    {
+                        value = static_cast<T>(v);
+                        return i + 1;
+                    }
+                }
+                return 0;
+            }
+
+            template <typename A>
+            constexpr bool is_negative(const A &a)
+            {
+                return std::is_signed<A>::value && a < A();
+            }
+        }
+
+        // BinaryParser
+        // Number T in the given byte order
+
+        template <typename T, bool big_endian>
+        struct BinaryParser : ParserBase<BinaryParser<T, big_endian>>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, T>
+            {
+                if (length(in) < sizeof(T))
+                    return nothing;
+                else
+                    return tuple(drop(sizeof(T), in), output(in));
+            }
+
+            constexpr size_t width() const
+            {
+                return sizeof(T);
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &) const
+            {
+                return true;
+            }
+
+            template <typename In>
+            T output(const In &in) const
+            {
+                return detail::load_number<T, big_endian>(in.data());
+            }
+        };
+
+        template <typename T, bool big_endian>
+        struct IsFixedWidth<BinaryParser<T, big_endian>> : std::true_type
+        {
+        };
+
+        constexpr BinaryParser<uint8_t, true> be_u8{};
+        constexpr BinaryParser<uint16_t, true> be_u16{};
+        constexpr BinaryParser<uint32_t, true> be_u32{};
+        constexpr BinaryParser<uint64_t, true> be_u64{};
+        constexpr BinaryParser<int8_t, true> be_i8{};
+        constexpr BinaryParser<int16_t, true> be_i16{};
+        constexpr BinaryParser<int32_t, true> be_i32{};
+        constexpr BinaryParser<int64_t, true> be_i64{};
+        constexpr BinaryParser<float, true> be_f32{};
+        constexpr BinaryParser<double, true> be_f64{};
+
+        constexpr BinaryParser<uint8_t, false> le_u8{};
+        constexpr BinaryParser<uint16_t, false> le_u16{};
+        constexpr BinaryParser<uint32_t, false> le_u32{};
+        constexpr BinaryParser<uint64_t, false> le_u64{};
+        constexpr BinaryParser<int8_t, false> le_i8{};
+        constexpr BinaryParser<int16_t, false> le_i16{};
+        constexpr BinaryParser<int32_t, false> le_i32{};
+        constexpr BinaryParser<int64_t, false> le_i64{};
+        constexpr BinaryParser<float, false> le_f32{};
+        constexpr BinaryParser<double, false> le_f64{};
+
+        // VarintParser
+        // Unsigned LEB128 varint of type T. Signed types are zigzag encoded, as sint32 and sint64 of protobuf.
+
+        template <typename T>
+        struct VarintParser : ParserBase<VarintParser<T>>
+        {
+            using U = typename std::make_unsigned<T>::type;
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, T>
+            {
+                U u = 0;
+                const size_t n = detail::decode_varint(in.data(), length(in), u);
+
+                if (n == 0)
+                    return nothing;
+                else
+                    return tuple(drop(n, in), decode(u));
+            }
+
+            // Incomplete while every byte continues the varint, up to its longest
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, T>
+            {
+                const size_t longest = (sizeof(T) * 8 + 6) / 7;
+
+                size_t i = 0;
+                while (i < length(in) && i < longest && (static_cast<uint8_t>(in[i]) & 0x80))
+                    ++i;
+
+                if (i == length(in) && i < longest)
+                    return detail::partial_incomplete<In, T>();
+                return detail::partial_decided(parse(in));
+            }
+
+            static T decode(U u)
+            {
+                if (std::is_signed<T>::value)
+                    return static_cast<T>((u >> 1) ^ (~(u & 1) + 1));
+                else
+                    return static_cast<T>(u);
+            }
+        };
+
+        constexpr VarintParser<uint32_t> varint_u32{};
+        constexpr VarintParser<uint64_t> varint_u64{};
+        constexpr VarintParser<int32_t> varint_s32{};
+        constexpr VarintParser<int64_t> varint_s64{};
+
+        // LengthDataParser
+        // Parses a length by p, and returns that many elements as a view of the input
+
+        template <typename P>
+        struct LengthDataParser : ParserBase<LengthDataParser<P>>
+        {
+            P p;
+
+            constexpr explicit LengthDataParser(const P &p)
+                : p(p) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                const auto res = p(in);
+                if (!res)
+                    return nothing;
+
+                const auto n = snd(res.value());
+                const In rest = fst(res.value());
+
+                if (detail::is_negative(n) || static_cast<uint64_t>(n) > length(rest))
+                    return nothing;
+
+                return tuple(drop(static_cast<size_t>(n), rest), take(static_cast<size_t>(n), rest));
+            }
+        };
+
+        template <typename P>
+        constexpr auto length_data(const P &p)
+            -> LengthDataParser<FuncToFuncPtr<P>>
+        {
+            return LengthDataParser<FuncToFuncPtr<P>>(p);
+        }
+
+        // Bit fields
+        // take_bits<n>(): n <= 64 bits as the smallest unsigned integer holding them.
+        // bool_bit: A single bit as bool.
+        // bit_tag<n>(v): n bits equal to v.
+        // bits(p): Runs p on the bits of a byte input, and resumes the byte input at the next byte boundary.
+        // Each field is a single 64-bit big-endian load from its byte, shifted into place, instead of a shift per bit.
+        // They are fixed width, so a header of fields in a tuple takes a single bounds check.
+
+        namespace detail
+        {
+            // Next n <= 57 bits of in, the first one as the most significant.
+            // The 8 bytes from the first one are loaded at once, or only those up to the end of the base if fewer.
+            inline uint64_t read_bits(const BitCursor &in, size_t n)
+            {
+                const size_t byte = in.offset() / 8;
+                const size_t readable = (in.end_offset() + 7) / 8 - byte;
+
+                uint64_t word = 0;
+                if (readable >= 8)
+                    std::memcpy(&word, in.base() + byte, 8);
+                else
+                    std::memcpy(&word, in.base() + byte, readable);
+                if (!host_big_endian)
+                    word = byte_swap(word);
+
+                return (word << (in.offset() % 8)) >> (63 - (n - 1));
+            }
+
+            template <size_t n>
+            inline uint64_t read_bits(const BitCursor &in)
+            {
+                if (n <= 57)
+                    return read_bits(in, n);
+                else
+                    return (read_bits(in, n - 32) << 32) | read_bits(drop(n - 32, in), 32);
+            }
+
+            template <size_t n>
+            using BitsOf = UintOf<(n <= 8 ? 1 : n <= 16 ? 2 : n <= 32 ? 4 : 8)>;
+        }
+
+        // TakeBitsParser
+        // n bits as an unsigned integer
+
+        template <size_t n>
+        struct TakeBitsParser : ParserBase<TakeBitsParser<n>>
+        {
+            static_assert(n > 0 && n <= 64, "take_bits supports 1 to 64 bits.");
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, detail::BitsOf<n>>
+            {
+                if (length(in) < n)
+                    return nothing;
+                else
+                    return tuple(drop(n, in), output(in));
+            }
+
+            constexpr size_t width() const
+            {
+                return n;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &) const
+            {
+                return true;
+            }
+
+            template <typename In>
+            detail::BitsOf<n> output(const In &in) const
+            {
+                return static_cast<detail::BitsOf<n>>(detail::read_bits<n>(in));
+            }
+        };
+
+        template <size_t n>
+        struct IsFixedWidth<TakeBitsParser<n>> : std::true_type
+        {
+        };
+
+        template <size_t n>
+        constexpr TakeBitsParser<n> take_bits()
+        {
+            return TakeBitsParser<n>{};
+        }
+
+        // BoolBitParser
+        // A single bit as bool
+
+        struct BoolBitParser : ParserBase<BoolBitParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, bool>
+            {
+                if (length(in) < 1)
+                    return nothing;
+                else
+                    return tuple(drop(1, in), output(in));
+            }
+
+            constexpr size_t width() const
+            {
+                return 1;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &) const
+            {
+                return true;
+            }
+
+            template <typename In>
+            bool output(const In &in) const
+            {
+                return detail::read_bits<1>(in) != 0;
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<BoolBitParser> : std::true_type
+        {
+        };
+
+        constexpr BoolBitParser bool_bit{};
+
+        // BitTagParser
+        // n bits equal to v
+
+        template <size_t n>
+        struct BitTagParser : ParserBase<BitTagParser<n>>
+        {
+            static_assert(n > 0 && n <= 64, "bit_tag supports 1 to 64 bits.");
+
+            detail::BitsOf<n> v;
+
+            constexpr explicit BitTagParser(detail::BitsOf<n> v)
+                : v(v) {}
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, detail::BitsOf<n>>
+            {
+                if (length(in) < n || !matches(in))
+                    return nothing;
+                else
+                    return tuple(drop(n, in), v);
+            }
+
+            constexpr size_t width() const
+            {
+                return n;
+            }
+
+            template <typename In>
+            bool matches(const In &in) const
+            {
+                return detail::read_bits<n>(in) == v;
+            }
+
+            template <typename In>
+            constexpr detail::BitsOf<n> output(const In &) const
+            {
+                return v;
+            }
+        };
+
+        template <size_t n>
+        struct IsFixedWidth<BitTagParser<n>> : std::true_type
+        {
+        };
+
+        template <size_t n>
+        constexpr BitTagParser<n> bit_tag(detail::BitsOf<n> v)
+        {
+            return BitTagParser<n>(v);
+        }
+
+        // BitsParser
+        // Runs p on a BitCursor over the input. A partly consumed byte is skipped.
+
+        template <typename P>
+        struct BitsParser : ParserBase<BitsParser<P>>
+        {
+            P p;
+
+            constexpr explicit BitsParser(const P &p)
+                : p(p) {}
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, CallParserO<P, BitCursor>>
+            {
+                const auto res = p(BitCursor(in.data(), 0, length(in) * 8));
+                if (!res)
+                    return nothing;
+
+                const size_t consumed = (fst(res.value()).offset() + 7) / 8;
+                return tuple(drop(consumed, in), snd(res.value()));
+            }
+        };
 
-        Tag<StringView> tag(const StringView &t)
+        template <typename P>
+        constexpr auto bits(const P &p)
+            -> BitsParser<FuncToFuncPtr<P>>
         {
-            return Tag<StringView>{t};
+            return BitsParser<FuncToFuncPtr<P>>(p);
         }
 
     } // namespace parser
@@ -1,7 +1,12 @@
 #ifndef EFP_TERMINAL_PARSER_HPP_
 #define EFP_TERMINAL_PARSER_HPP_
 
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
 #include "parser_base.hpp"
+#include "parser_combinator.hpp"
 
 // alpha0/alpha1: Parses zero or more, or one or more alphabetic characters.
 // alphanumeric0/alphanumeric1: Parses zero or more, or one or more alphanumeric characters.
@@ -21,77 +26,375 @@
 // satisfy: Matches a character that satisfies a predicate.
 // space0/space1: Parses zero or more, or one or more space characters.
 // tab: Matches a tab character.
+// skip_*: Non-capturing variants of the run parsers.
 
 namespace efp
 {
     namespace parser
     {
+        namespace detail
+        {
+            // Character classes of the "C" locale, usable in constant expressions
+            constexpr bool is_alpha(char c)
+            {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            }
+
+            constexpr bool is_digit(char c)
+            {
+                return c >= '0' && c <= '9';
+            }
+
+            constexpr bool is_alnum(char c)
+            {
+                return is_alpha(c) || is_digit(c);
+            }
+
+            constexpr bool is_hex_digit(char c)
+            {
+                return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+            }
+
+            constexpr bool is_space(char c)
+            {
+                return c == ' ' || (c >= '\t' && c <= '\r');
+            }
+
+            constexpr bool is_oct_digit(char c)
+            {
+                return c >= '0' && c <= '7';
+            }
+
+            constexpr bool is_blank_space(char c)
+            {
+                return c == ' ';
+            }
+
+            constexpr bool is_not_line_ending(char c)
+            {
+                return c != '\n' && c != '\r';
+            }
+
+            // Set of byte values
+            struct CharSet
+            {
+                uint64_t bits[4];
+
+                constexpr CharSet()
+                    : bits{0, 0, 0, 0} {}
+
+                constexpr explicit CharSet(const StringView &chars)
+                    : bits{0, 0, 0, 0}
+                {
+                    for (size_t i = 0; i < length(chars); ++i)
+                        insert(static_cast<unsigned char>(chars[i]));
+                }
+
+                constexpr void insert(unsigned char c)
+                {
+                    bits[c >> 6] |= uint64_t(1) << (c & 63);
+                }
+
+                constexpr bool contains(unsigned char c) const
+                {
+                    return (bits[c >> 6] >> (c & 63)) & 1;
+                }
+
+                template <typename Pred>
+                static CharSet of(const Pred &pred)
+                {
+                    CharSet res;
+                    for (int c = 0; c < 256; ++c)
+                    {
+                        if (pred(static_cast<char>(c)))
+                            res.insert(static_cast<unsigned char>(c));
+                    }
+                    return res;
+                }
+            };
+
+            // Decimal integer of type T, with a leading '-' if T is signed. Fails if it does not fit in T.
+            template <typename T, typename In>
+            constexpr auto parse_integer(const In &in) -> Parsed<In, T>
+            {
+                const bool negative = std::is_signed<T>::value && length(in) > 0 && in[0] == '-';
+                const size_t start = negative ? 1 : 0;
+                const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+                uint64_t value = 0;
+                size_t i = start;
+                while (i < length(in) && is_digit(in[i]))
+                {
+                    const uint64_t d = static_cast<uint64_t>(in[i] - '0');
+                    if (value > (limit - d) / 10)
+                        return nothing;
+
+                    value = value * 10 + d;
+                    ++i;
+                }
+
+                if (i == start)
+                    return nothing;
+                else if (negative)
+                    return tuple(drop(i, in), static_cast<T>(-static_cast<int64_t>(value - 1) - 1));
+                else
+                    return tuple(drop(i, in), static_cast<T>(value));
+            }
+
+            // Match of parse_integer<T>, which is only converted if it has enough digits to overflow
+            template <typename T, typename In>
+            constexpr auto skim_integer(const In &in) -> Maybe<In>
+            {
+                const size_t start = std::is_signed<T>::value && length(in) > 0 && in[0] == '-' ? 1 : 0;
+
+                size_t i = start;
+                while (i < length(in) && is_digit(in[i]))
+                    ++i;
+
+                if (i == start)
+                    return nothing;
+                else if (i - start <= static_cast<size_t>(std::numeric_limits<T>::digits10))
+                    return drop(i, in);
+
+                const auto res = parse_integer<T>(in);
+                if (!res)
+                    return nothing;
+
+                return fst(res.value());
+            }
+
+            // Step of parse_integer<T>
+            template <typename T>
+            constexpr auto step_integer(const char *begin, const char *end) -> Step<T>
+            {
+                const bool negative = std::is_signed<T>::value && begin != end && *begin == '-';
+                const char *start = negative ? begin + 1 : begin;
+                const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+                uint64_t value = 0;
+                const char *p = start;
+                while (p != end && is_digit(*p))
+                {
+                    const uint64_t d = static_cast<uint64_t>(*p - '0');
+                    if (value > (limit - d) / 10)
+                        return Step<T>{nullptr, 0};
+
+                    value = value * 10 + d;
+                    ++p;
+                }
+
+                if (p == start)
+                    return Step<T>{nullptr, 0};
+                else if (negative)
+                    return Step<T>{p, static_cast<T>(-static_cast<int64_t>(value - 1) - 1)};
+                else
+                    return Step<T>{p, static_cast<T>(value)};
+            }
+
+            // Step of a run of at least min characters for which pred holds
+            template <bool (*pred)(char)>
+            constexpr Step<Matched> step_while(const char *begin, const char *end, size_t min)
+            {
+                const char *p = begin;
+                while (p != end && pred(*p))
+                    ++p;
+
+                return Step<Matched>{static_cast<size_t>(p - begin) >= min ? p : nullptr};
+            }
+
+            // Partial result of a run of characters for which pred holds, decided by the first for which it does not
+            template <bool (*pred)(char), typename P, typename In>
+            auto partial_while(const P &p, const In &in) -> Partial<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && pred(in[i]))
+                    ++i;
+
+                if (i == length(in))
+                    return partial_incomplete<In, In>();
+                return partial_decided(p.parse(in));
+            }
+
+            // Partial result of parse_integer<T>, decided by the first character after its digits
+            template <typename T, typename In>
+            auto partial_integer(const In &in) -> Partial<In, T>
+            {
+                size_t i = std::is_signed<T>::value && length(in) > 0 && in[0] == '-' ? 1 : 0;
+                while (i < length(in) && is_digit(in[i]))
+                    ++i;
+
+                if (i == length(in))
+                    return partial_incomplete<In, T>();
+                return partial_decided(parse_integer<T>(in));
+            }
+
+            // Partial result of a parser of a single character
+            template <typename P, typename In>
+            auto partial_char(const P &p, const In &in) -> Partial<In, char>
+            {
+                if (length(in) == 0)
+                    return partial_incomplete<In, char>();
+                return partial_decided(p.parse(in));
+            }
+        }
 
         // Function alpha0: Parses zero or more alphabetic characters
-        auto alpha0(const StringView &in) -> Parsed<StringView, StringView>
+        struct Alpha0Parser : ParserBase<Alpha0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isalpha(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && detail::is_alpha(in[i]))
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_alpha>(begin, end, 0);
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_alpha>(*this, in);
+            }
+        };
+
+        constexpr Alpha0Parser alpha0{};
 
         // Function alpha1: Parses one or more alphabetic characters
-        auto alpha1(const StringView &in) -> Parsed<StringView, StringView>
+        struct Alpha1Parser : ParserBase<Alpha1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isalpha(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_alpha(in[i]))
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_alpha>(begin, end, 1);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_alpha>(*this, in);
+            }
+        };
+
+        constexpr Alpha1Parser alpha1{};
 
         // alphanumeric0: Parses zero or more alphanumeric characters
-        auto alphanumeric0(const StringView &in) -> Parsed<StringView, StringView>
+        struct Alphanumeric0Parser : ParserBase<Alphanumeric0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isalnum(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_alnum(in[i]))
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_alnum>(begin, end, 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_alnum>(*this, in);
+            }
+        };
+
+        constexpr Alphanumeric0Parser alphanumeric0{};
 
         // alphanumeric1: Parses one or more alphanumeric characters
-        auto alphanumeric1(const StringView &in) -> Parsed<StringView, StringView>
+        struct Alphanumeric1Parser : ParserBase<Alphanumeric1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isalnum(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_alnum(in[i]))
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_alnum>(begin, end, 1);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_alnum>(*this, in);
+            }
+        };
+
+        constexpr Alphanumeric1Parser alphanumeric1{};
 
         // anychar: Matches any single character
-        auto anychar(const StringView &in) -> Parsed<StringView, char>
+        struct AnyCharParser : ParserBase<AnyCharParser>
         {
-            if (length(in) > 0)
-                return tuple(drop(1, in), in[0]);
-            else
-                return nothing;
-        }
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
+            {
+                if (length(in) > 0)
+                    return tuple(drop(1, in), in[0]);
+                else
+                    return nothing;
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<char>
+            {
+                if (begin != end)
+                    return Step<char>{begin + 1, *begin};
+                else
+                    return Step<char>{nullptr, 0};
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, char>
+            {
+                return detail::partial_char(*this, in);
+            }
+        };
+
+        constexpr AnyCharParser anychar{};
 
         // ch: Recognizes a specific character
-        struct ChParser
+        struct ChParser : ParserBase<ChParser>
         {
             const char c;
 
-            Parsed<StringView, char> operator()(const StringView &in) const
+            constexpr explicit ChParser(char c)
+                : c(c) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
             {
                 if (length(in) > 0)
                 {
@@ -102,341 +405,860 @@ namespace efp
                 }
                 return nothing;
             }
+
+            constexpr size_t width() const
+            {
+                return 1;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                return in[0] == c;
+            }
+
+            template <typename In>
+            constexpr char output(const In &) const
+            {
+                return c;
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<ChParser> : std::true_type
+        {
         };
 
-        ChParser ch(char c)
+        constexpr ChParser ch(char c)
         {
-            return ChParser{c};
+            return ChParser(c);
         }
 
         // crlf: Matches the string "\r\n"
-        auto crlf(const StringView &in) -> Parsed<StringView, StringView>
+        struct CrlfParser : ParserBase<CrlfParser>
         {
-            if (length(in) >= 2 && in[0] == '\r' && in[1] == '\n')
-                return tuple(drop(2, in), take(2, in));
-            else
-                return nothing;
-        }
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                if (length(in) >= 2 && in[0] == '\r' && in[1] == '\n')
+                    return tuple(drop(2, in), take(2, in));
+                else
+                    return nothing;
+            }
+
+            constexpr size_t width() const
+            {
+                return 2;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                return (in[0] == '\r') & (in[1] == '\n');
+            }
+
+            template <typename In>
+            constexpr In output(const In &in) const
+            {
+                return take(2, in);
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<CrlfParser> : std::true_type
+        {
+        };
+
+        constexpr CrlfParser crlf{};
 
         // digit0: Parses zero or more numeric characters
-        auto digit0(const StringView &in) -> Parsed<StringView, StringView>
+        struct Digit0Parser : ParserBase<Digit0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isdigit(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_digit(in[i]))
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_digit>(begin, end, 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_digit>(*this, in);
+            }
+        };
+
+        constexpr Digit0Parser digit0{};
 
         // digit1: Parses one or more numeric characters
-        auto digit1(const StringView &in) -> Parsed<StringView, StringView>
+        struct Digit1Parser : ParserBase<Digit1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isdigit(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_digit(in[i]))
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_digit>(begin, end, 1);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_digit>(*this, in);
+            }
+        };
+
+        constexpr Digit1Parser digit1{};
 
         // hex_digit0: Parses zero or more hexadecimal digits
-        auto hex_digit0(const StringView &in) -> Parsed<StringView, StringView>
+        struct HexDigit0Parser : ParserBase<HexDigit0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isxdigit(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_hex_digit(in[i]))
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_hex_digit>(begin, end, 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_hex_digit>(*this, in);
+            }
+        };
+
+        constexpr HexDigit0Parser hex_digit0{};
 
         // hex_digit1: Parses one or more hexadecimal digits
-        auto hex_digit1(const StringView &in) -> Parsed<StringView, StringView>
+        struct HexDigit1Parser : ParserBase<HexDigit1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isxdigit(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && detail::is_hex_digit(in[i]))
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_hex_digit>(begin, end, 1);
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_hex_digit>(*this, in);
+            }
+        };
+
+        constexpr HexDigit1Parser hex_digit1{};
 
         // line_ending: Recognizes an end of line (both ‘\n’ and ‘\r\n’).
-        auto line_ending(const StringView &in) -> Parsed<StringView, StringView>
+        struct LineEndingParser : ParserBase<LineEndingParser>
         {
-            if (start_with(in, "\r\n"))
-                return tuple(drop(2, in), take(2, in));
-            else if (start_with(in, "\n"))
-                return tuple(drop(1, in), take(1, in));
-            else
-                return nothing;
-        }
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                if (start_with(in, "\r\n"))
+                    return tuple(drop(2, in), take(2, in));
+                else if (start_with(in, "\n"))
+                    return tuple(drop(1, in), take(1, in));
+                else
+                    return nothing;
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                if (end - begin >= 2 && begin[0] == '\r' && begin[1] == '\n')
+                    return Step<Matched>{begin + 2};
+                else if (begin != end && begin[0] == '\n')
+                    return Step<Matched>{begin + 1};
+                else
+                    return Step<Matched>{nullptr};
+            }
+
+            // A '\r' at the end may yet be followed by '\n'
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                if (length(in) == 0 || (length(in) == 1 && in[0] == '\r'))
+                    return detail::partial_incomplete<In, In>();
+                return detail::partial_decided(parse(in));
+            }
+        };
+
+        constexpr LineEndingParser line_ending{};
 
         // multispace0: Recognizes zero or more whitespace characters
-        auto multispace0(const StringView &in) -> Parsed<StringView, StringView>
+        struct Multispace0Parser : ParserBase<Multispace0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isspace(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && detail::is_space(in[i]))
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_space>(begin, end, 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_space>(*this, in);
+            }
+        };
+
+        constexpr Multispace0Parser multispace0{};
 
         // multispace1: Recognizes one or more whitespace characters
-        auto multispace1(const StringView &in) -> Parsed<StringView, StringView>
+        struct Multispace1Parser : ParserBase<Multispace1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && std::isspace(in[i]))
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && detail::is_space(in[i]))
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_space>(begin, end, 1);
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_space>(*this, in);
+            }
+        };
+
+        constexpr Multispace1Parser multispace1{};
 
         // newline: Matches a newline character ‘\n’
-        auto newline(const StringView &in) -> Parsed<StringView, char>
+        struct NewlineParser : ParserBase<NewlineParser>
         {
-            if (!in.empty() && in[0] == '\n')
-                return tuple(drop(1, in), in[0]);
-            else
-                return nothing;
-        }
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
+            {
+                if (!in.empty() && in[0] == '\n')
+                    return tuple(drop(1, in), in[0]);
+                else
+                    return nothing;
+            }
+
+            constexpr size_t width() const
+            {
+                return 1;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                return in[0] == '\n';
+            }
+
+            template <typename In>
+            constexpr char output(const In &) const
+            {
+                return '\n';
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<NewlineParser> : std::true_type
+        {
+        };
 
-        // none_of: Recognizes a character that is not in the provided characters
-        struct NoneOfParser
+        constexpr NewlineParser newline{};
+
+        // none_of: Recognizes a character that is not in the provided characters.
+        // The characters are compiled into a set on construction, and only read while parsing.
+        struct NoneOfParser : ParserBase<NoneOfParser>
         {
             StringView chars_to_avoid;
+            detail::CharSet set;
 
-            NoneOfParser(const char *chars)
-                : chars_to_avoid(StringView(chars)) {}
+            constexpr NoneOfParser(const char *chars)
+                : chars_to_avoid(StringView(chars)), set(chars_to_avoid) {}
 
-            Parsed<StringView, char> operator()(const StringView &in) const
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
             {
-                if (length(in) > 0 && !elem_index(in[0], chars_to_avoid))
+                if (length(in) > 0 && !set.contains(static_cast<unsigned char>(in[0])))
                     return tuple(drop(1, in), in[0]);
                 else
                     return nothing;
             }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<char>
+            {
+                if (begin != end && !set.contains(static_cast<unsigned char>(*begin)))
+                    return Step<char>{begin + 1, *begin};
+                else
+                    return Step<char>{nullptr, 0};
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, char>
+            {
+                return detail::partial_char(*this, in);
+            }
         };
 
-        auto none_of(const char *chars) -> NoneOfParser
+        constexpr auto none_of(const char *chars) -> NoneOfParser
         {
             return NoneOfParser(chars);
         }
 
         // not_line_ending: Recognizes a string of any char except ‘\r\n’ or ‘\n’.
-        auto not_line_ending(const StringView &in) -> Parsed<StringView, StringView>
+        struct NotLineEndingParser : ParserBase<NotLineEndingParser>
         {
-            size_t i = 0;
-            while (i < length(in) && in[i] != '\n' && in[i] != '\r')
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && in[i] != '\n' && in[i] != '\r')
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_not_line_ending>(begin, end, 1);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_not_line_ending>(*this, in);
+            }
+        };
+
+        constexpr NotLineEndingParser not_line_ending{};
 
         // oct_digit0: Parses zero or more octal characters (0-7)
-        auto oct_digit0(const StringView &in) -> Parsed<StringView, StringView>
+        struct OctDigit0Parser : ParserBase<OctDigit0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && in[i] >= '0' && in[i] <= '7')
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && in[i] >= '0' && in[i] <= '7')
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_oct_digit>(begin, end, 0);
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_oct_digit>(*this, in);
+            }
+        };
+
+        constexpr OctDigit0Parser oct_digit0{};
 
         // oct_digit1: Parses one or more octal characters (0-7)
-        auto oct_digit1(const StringView &in) -> Parsed<StringView, StringView>
+        struct OctDigit1Parser : ParserBase<OctDigit1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && in[i] >= '0' && in[i] <= '7')
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && in[i] >= '0' && in[i] <= '7')
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_oct_digit>(begin, end, 1);
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
 
-        // one_of: Recognizes one of the provided characters
-        struct OneOfParser
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_oct_digit>(*this, in);
+            }
+        };
+
+        constexpr OctDigit1Parser oct_digit1{};
+
+        // one_of: Recognizes one of the provided characters.
+        // The characters are compiled into a set on construction, and only read while parsing.
+        struct OneOfParser : ParserBase<OneOfParser>
         {
             StringView chars_to_match;
+            detail::CharSet set;
 
-            OneOfParser(const char *chars)
-                : chars_to_match(StringView(chars)) {}
+            constexpr OneOfParser(const char *chars)
+                : chars_to_match(StringView(chars)), set(chars_to_match) {}
 
-            Parsed<StringView, char> operator()(const StringView &in) const
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
             {
-                if (length(in) > 0 && elem_index(in[0], chars_to_match))
+                if (length(in) > 0 && set.contains(static_cast<unsigned char>(in[0])))
                     return tuple(drop(1, in), in[0]);
                 else
                     return nothing;
             }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<char>
+            {
+                if (begin != end && set.contains(static_cast<unsigned char>(*begin)))
+                    return Step<char>{begin + 1, *begin};
+                else
+                    return Step<char>{nullptr, 0};
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, char>
+            {
+                return detail::partial_char(*this, in);
+            }
         };
 
-        auto one_of(const char *chars) -> OneOfParser
+        constexpr auto one_of(const char *chars) -> OneOfParser
         {
             return OneOfParser(chars);
         }
 
-        Parsed<StringView, int8_t> parse_int8(const StringView &in)
+        struct Int8Parser : ParserBase<Int8Parser>
         {
-            int temp;
-            if (sscanf(in.data(), "%d", &temp) == 1 && temp >= std::numeric_limits<int8_t>::min() && temp <= std::numeric_limits<int8_t>::max())
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, int8_t>
             {
-                return tuple(drop_while(isdigit, in), static_cast<int8_t>(temp));
+                return detail::parse_integer<int8_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, int16_t> parse_int16(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<int8_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<int8_t>
+            {
+                return detail::step_integer<int8_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, int8_t>
+            {
+                return detail::partial_integer<int8_t>(in);
+            }
+        };
+
+        constexpr Int8Parser parse_int8{};
+
+        struct Int16Parser : ParserBase<Int16Parser>
         {
-            int temp;
-            if (sscanf(in.data(), "%d", &temp) == 1 && temp >= std::numeric_limits<int16_t>::min() && temp <= std::numeric_limits<int16_t>::max())
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, int16_t>
             {
-                return tuple(drop_while(isdigit, in), static_cast<int16_t>(temp));
+                return detail::parse_integer<int16_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, int32_t> parse_int32(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<int16_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<int16_t>
+            {
+                return detail::step_integer<int16_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, int16_t>
+            {
+                return detail::partial_integer<int16_t>(in);
+            }
+        };
+
+        constexpr Int16Parser parse_int16{};
+
+        struct Int32Parser : ParserBase<Int32Parser>
         {
-            int32_t temp;
-            if (sscanf(in.data(), "%d", &temp) == 1)
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, int32_t>
             {
-                return tuple(drop_while(isdigit, in), temp);
+                return detail::parse_integer<int32_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, int64_t> parse_int64(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<int32_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<int32_t>
+            {
+                return detail::step_integer<int32_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, int32_t>
+            {
+                return detail::partial_integer<int32_t>(in);
+            }
+        };
+
+        constexpr Int32Parser parse_int32{};
+
+        struct Int64Parser : ParserBase<Int64Parser>
         {
-            int64_t temp;
-            if (sscanf(in.data(), "%lld", &temp) == 1)
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, int64_t>
             {
-                return tuple(drop_while(isdigit, in), temp);
+                return detail::parse_integer<int64_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, uint8_t> parse_uint8(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<int64_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<int64_t>
+            {
+                return detail::step_integer<int64_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, int64_t>
+            {
+                return detail::partial_integer<int64_t>(in);
+            }
+        };
+
+        constexpr Int64Parser parse_int64{};
+
+        struct Uint8Parser : ParserBase<Uint8Parser>
         {
-            unsigned int temp;
-            if (sscanf(in.data(), "%u", &temp) == 1 && temp <= std::numeric_limits<uint8_t>::max())
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, uint8_t>
             {
-                return tuple(drop_while(isdigit, in), static_cast<uint8_t>(temp));
+                return detail::parse_integer<uint8_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, uint16_t> parse_uint16(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<uint8_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<uint8_t>
+            {
+                return detail::step_integer<uint8_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, uint8_t>
+            {
+                return detail::partial_integer<uint8_t>(in);
+            }
+        };
+
+        constexpr Uint8Parser parse_uint8{};
+
+        struct Uint16Parser : ParserBase<Uint16Parser>
         {
-            unsigned int temp;
-            if (sscanf(in.data(), "%u", &temp) == 1 && temp <= std::numeric_limits<uint16_t>::max())
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, uint16_t>
             {
-                return tuple(drop_while(isdigit, in), static_cast<uint16_t>(temp));
+                return detail::parse_integer<uint16_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, uint32_t> parse_uint32(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<uint16_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<uint16_t>
+            {
+                return detail::step_integer<uint16_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, uint16_t>
+            {
+                return detail::partial_integer<uint16_t>(in);
+            }
+        };
+
+        constexpr Uint16Parser parse_uint16{};
+
+        struct Uint32Parser : ParserBase<Uint32Parser>
         {
-            uint32_t temp;
-            if (sscanf(in.data(), "%u", &temp) == 1)
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, uint32_t>
             {
-                return tuple(drop_while(isdigit, in), temp);
+                return detail::parse_integer<uint32_t>(in);
             }
-            return nothing;
-        }
 
-        Parsed<StringView, uint64_t> parse_uint64(const StringView &in)
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<uint32_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<uint32_t>
+            {
+                return detail::step_integer<uint32_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, uint32_t>
+            {
+                return detail::partial_integer<uint32_t>(in);
+            }
+        };
+
+        constexpr Uint32Parser parse_uint32{};
+
+        struct Uint64Parser : ParserBase<Uint64Parser>
         {
-            uint64_t temp;
-            if (sscanf(in.data(), "%llu", &temp) == 1)
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, uint64_t>
             {
-                return tuple(drop_while(isdigit, in), temp);
+                return detail::parse_integer<uint64_t>(in);
             }
-            return nothing;
-        }
+
+            template <typename In>
+            constexpr auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::skim_integer<uint64_t>(in);
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<uint64_t>
+            {
+                return detail::step_integer<uint64_t>(begin, end);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, uint64_t>
+            {
+                return detail::partial_integer<uint64_t>(in);
+            }
+        };
+
+        constexpr Uint64Parser parse_uint64{};
 
         // satisfy: Recognizes one character and checks that it satisfies a predicate
         template <typename Predicate>
-        struct SatisfyParser
+        struct SatisfyParser : ParserBase<SatisfyParser<Predicate>>
         {
             Predicate pred;
 
-            explicit SatisfyParser(Predicate p) : pred(p) {}
+            constexpr explicit SatisfyParser(Predicate p) : pred(p) {}
 
-            Parsed<StringView, char> operator()(const StringView &in) const
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
             {
                 if (length(in) > 0 && pred(in[0]))
                     return tuple(drop(1, in), in[0]);
                 else
                     return nothing;
             }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, char>
+            {
+                return detail::partial_char(*this, in);
+            }
         };
 
         // Constructor function for SatisfyParser
         template <typename Predicate>
-        auto satisfy(Predicate p) -> SatisfyParser<Predicate>
+        constexpr auto satisfy(Predicate p) -> SatisfyParser<Predicate>
         {
             return SatisfyParser<Predicate>(p);
         }
 
         // space0: Parses zero or more space characters
-        auto space0(const StringView &in) -> Parsed<StringView, StringView>
+        struct Space0Parser : ParserBase<Space0Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && in[i] == ' ')
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
+            {
+                size_t i = 0;
+                while (i < length(in) && in[i] == ' ')
+                {
+                    ++i;
+                }
+                return tuple(drop(i, in), take(i, in));
+            }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
             {
-                ++i;
+                return detail::step_while<detail::is_blank_space>(begin, end, 0);
             }
-            return tuple(drop(i, in), take(i, in));
-        }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_blank_space>(*this, in);
+            }
+        };
+
+        constexpr Space0Parser space0{};
 
         // space1: Parses one or more space characters
-        auto space1(const StringView &in) -> Parsed<StringView, StringView>
+        struct Space1Parser : ParserBase<Space1Parser>
         {
-            size_t i = 0;
-            while (i < length(in) && in[i] == ' ')
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, In>
             {
-                ++i;
+                size_t i = 0;
+                while (i < length(in) && in[i] == ' ')
+                {
+                    ++i;
+                }
+                if (i > 0)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
             }
-            if (i > 0)
-                return tuple(drop(i, in), take(i, in));
-            else
-                return nothing;
-        }
+
+            constexpr auto parse_step(const char *begin, const char *end) const -> Step<Matched>
+            {
+                return detail::step_while<detail::is_blank_space>(begin, end, 1);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, In>
+            {
+                return detail::partial_while<detail::is_blank_space>(*this, in);
+            }
+        };
+
+        constexpr Space1Parser space1{};
 
         // tab: Matches a tab character ‘\t’
-        auto tab(const StringView &in) -> Parsed<StringView, char>
+        struct TabParser : ParserBase<TabParser>
         {
-            if (!in.empty() && in[0] == '\t')
-                return tuple(drop(1, in), '\t');
-            else
-                return nothing;
-        }
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Parsed<In, char>
+            {
+                if (!in.empty() && in[0] == '\t')
+                    return tuple(drop(1, in), '\t');
+                else
+                    return nothing;
+            }
 
-    }
+            constexpr size_t width() const
+            {
+                return 1;
+            }
+
+            template <typename In>
+            constexpr bool matches(const In &in) const
+            {
+                return in[0] == '\t';
+            }
 
-    
+            template <typename In>
+            constexpr char output(const In &) const
+            {
+                return '\t';
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<TabParser> : std::true_type
+        {
+        };
+
+        constexpr TabParser tab{};
+
+        // Non-capturing variants of the run parsers.
+        // Output is Skipped, so the matched slice is never constructed once inlined.
+
+        constexpr auto skip_alpha0 = skip(alpha0);
+        constexpr auto skip_alpha1 = skip(alpha1);
+        constexpr auto skip_alphanumeric0 = skip(alphanumeric0);
+        constexpr auto skip_alphanumeric1 = skip(alphanumeric1);
+        constexpr auto skip_digit0 = skip(digit0);
+        constexpr auto skip_digit1 = skip(digit1);
+        constexpr auto skip_hex_digit0 = skip(hex_digit0);
+        constexpr auto skip_hex_digit1 = skip(hex_digit1);
+        constexpr auto skip_multispace0 = skip(multispace0);
+        constexpr auto skip_multispace1 = skip(multispace1);
+        constexpr auto skip_not_line_ending = skip(not_line_ending);
+        constexpr auto skip_oct_digit0 = skip(oct_digit0);
+        constexpr auto skip_oct_digit1 = skip(oct_digit1);
+        constexpr auto skip_space0 = skip(space0);
+        constexpr auto skip_space1 = skip(space1);
+    }
 }
 
 #endif
\ No newline at end of file
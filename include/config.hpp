@@ -0,0 +1,16 @@
+#ifndef EFP_PARSER_CONFIG_HPP_
+#define EFP_PARSER_CONFIG_HPP_
+
+// EFP_PARSER_SEPARATE_COMPILATION
+// Defined by the efp_parser library target. The heavier non-template functions are then only declared in the headers
+// and compiled once into the library. The parsers themselves are templates, constexpr or defined in their class, so
+// they are inline and instantiated where they are used either way.
+// Otherwise the library is header-only, and every function defined in a header is inline.
+
+#if defined(EFP_PARSER_SEPARATE_COMPILATION)
+#define EFP_PARSER_DECL
+#else
+#define EFP_PARSER_DECL inline
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef EFP_CURSOR_HPP_
+#define EFP_CURSOR_HPP_
+
+#include "prelude.hpp"
+#include "string.hpp"
+
+namespace efp
+{
+    namespace parser
+    {
+        // Cursor
+        // Character input as a base pointer with begin and end offsets.
+        // Advancing is a single offset bump, and the offset from the start of the whole input is always at hand.
+
+        class Cursor
+        {
+        public:
+            Cursor()
+                : base_(nullptr), begin_(0), end_(0) {}
+
+            explicit Cursor(const char *in)
+                : Cursor(StringView(in)) {}
+
+            explicit Cursor(const StringView &in)
+                : base_(in.data()), begin_(0), end_(length(in)) {}
+
+            Cursor(const char *base, size_t begin, size_t end)
+                : base_(base), begin_(begin), end_(end) {}
+
+            const char *base() const
+            {
+                return base_;
+            }
+
+            // Offset of the first character from the base
+            size_t offset() const
+            {
+                return begin_;
+            }
+
+            // Offset of the end from the base
+            size_t end_offset() const
+            {
+                return end_;
+            }
+
+            const char *data() const
+            {
+                return base_ + begin_;
+            }
+
+            size_t size() const
+            {
+                return end_ - begin_;
+            }
+
+            bool empty() const
+            {
+                return begin_ == end_;
+            }
+
+            const char &operator[](size_t i) const
+            {
+                return base_[begin_ + i];
+            }
+
+            StringView view() const
+            {
+                return StringView(data(), size());
+            }
+
+            bool operator==(const StringView &other) const
+            {
+                return view() == other;
+            }
+
+            bool operator!=(const StringView &other) const
+            {
+                return !(view() == other);
+            }
+
+        private:
+            const char *base_;
+            size_t begin_;
+            size_t end_;
+        };
+
+        // BitCursor
+        // Bit input over a byte buffer, as a base pointer with begin and end offsets in bits.
+        // Bits are numbered from the most significant bit of each byte, as in network byte order.
+
+        class BitCursor
+        {
+        public:
+            BitCursor()
+                : base_(nullptr), begin_(0), end_(0) {}
+
+            explicit BitCursor(const StringView &in)
+                : base_(in.data()), begin_(0), end_(length(in) * 8) {}
+
+            BitCursor(const char *base, size_t begin, size_t end)
+                : base_(base), begin_(begin), end_(end) {}
+
+            const char *base() const
+            {
+                return base_;
+            }
+
+            // Offset of the first bit from the base
+            size_t offset() const
+            {
+                return begin_;
+            }
+
+            // Offset of the end from the base, in bits
+            size_t end_offset() const
+            {
+                return end_;
+            }
+
+            // Number of bits
+            size_t size() const
+            {
+                return end_ - begin_;
+            }
+
+            bool empty() const
+            {
+                return begin_ == end_;
+            }
+
+            bool operator[](size_t i) const
+            {
+                const size_t bit = begin_ + i;
+                return (static_cast<unsigned char>(base_[bit / 8]) >> (7 - bit % 8)) & 1;
+            }
+
+        private:
+            const char *base_;
+            size_t begin_;
+            size_t end_;
+        };
+
+        // Keep the efp overloads visible next to the Cursor ones
+        using efp::drop;
+        using efp::drop_while;
+        using efp::length;
+        using efp::take;
+
+        inline size_t length(const Cursor &in)
+        {
+            return in.size();
+        }
+
+        inline Cursor drop(size_t n, const Cursor &in)
+        {
+            return Cursor(in.base(), in.offset() + n, in.end_offset());
+        }
+
+        inline Cursor take(size_t n, const Cursor &in)
+        {
+            return Cursor(in.base(), in.offset(), in.offset() + n);
+        }
+
+        inline size_t length(const BitCursor &in)
+        {
+            return in.size();
+        }
+
+        inline BitCursor drop(size_t n, const BitCursor &in)
+        {
+            return BitCursor(in.base(), in.offset() + n, in.end_offset());
+        }
+
+        inline BitCursor take(size_t n, const BitCursor &in)
+        {
+            return BitCursor(in.base(), in.offset(), in.offset() + n);
+        }
+
+        template <typename F>
+        Cursor drop_while(const F &f, const Cursor &in)
+        {
+            size_t i = 0;
+            while (i < length(in) && f(in[i]))
+            {
+                ++i;
+            }
+            return drop(i, in);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef EFP_ESCAPED_STRING_PARSER_HPP_
+#define EFP_ESCAPED_STRING_PARSER_HPP_
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "parser_base.hpp"
+
+// escaped_string: Parses a double quoted string with backslash escapes, as in JSON.
+// Control characters must be escaped, and fail the parse if they appear as they are.
+// The closing quote is found 16 bytes at a time, and only the escapes themselves are decoded while parsing.
+// The output is a zero-copy view of the raw contents. Unescaping is deferred until asked for,
+// and then writes into a caller provided buffer, which never needs to be larger than the raw contents.
+// The input must expose contiguous data(), e.g. StringView or Cursor.
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+            // Characters which JSON only allows escaped within a string
+            constexpr bool is_control(char c)
+            {
+                return static_cast<unsigned char>(c) < 0x20;
+            }
+
+            // First quote, backslash or control character in [p, end), or end if none
+            inline const char *find_quote_backslash_or_control(const char *p, const char *end)
+            {
+#if defined(__SSE2__)
+                const __m128i quote = _mm_set1_epi8('"');
+                const __m128i backslash = _mm_set1_epi8('\\');
+                const __m128i last_control = _mm_set1_epi8(0x1F);
+
+                while (end - p >= 16)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, last_control), v);
+                    const int mask = _mm_movemask_epi8(
+                        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), control));
+
+                    if (mask != 0)
+                        return p + __builtin_ctz(static_cast<unsigned>(mask));
+
+                    p += 16;
+                }
+#endif
+                while (p != end && *p != '"' && *p != '\\' && !is_control(*p))
+                {
+                    ++p;
+                }
+                return p;
+            }
+
+            // Decodes the escape sequence at p, which starts with a backslash.
+            // Returns its length, or 0 if it is invalid or truncated.
+            EFP_PARSER_DECL size_t decode_escape(const char *p, size_t size, char32_t &cp);
+
+            EFP_PARSER_DECL size_t encode_utf8(char32_t cp, char *out);
+        }
+
+        // EscapedString
+        // Output of escaped_string. The raw contents between the quotes, escapes not decoded yet.
+
+        struct EscapedString
+        {
+            StringView raw;
+            bool has_escapes;
+
+            // Unescaped contents written to out, which must have room for raw.size() characters.
+            // Stops before a quote, a control character or an invalid escape, none of which the parser leaves in raw.
+            // Returns the unescaped length.
+            size_t unescape(char *out) const;
+
+            // The raw contents if there is nothing to unescape, otherwise the contents unescaped into buffer
+            StringView value(char *buffer) const
+            {
+                if (!has_escapes)
+                    return raw;
+                else
+                    return StringView(buffer, unescape(buffer));
+            }
+        };
+
+        // escaped_string: Parses a double quoted string with backslash escapes
+        struct EscapedStringParser : ParserBase<EscapedStringParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, EscapedString>
+            {
+                const size_t size = length(in);
+                if (size == 0 || in[0] != '"')
+                    return nothing;
+
+                const char *p = in.data();
+                bool has_escapes = false;
+
+                size_t i = 1;
+                while (true)
+                {
+                    i = static_cast<size_t>(detail::find_quote_backslash_or_control(p + i, p + size) - p);
+                    if (i == size || detail::is_control(p[i]))
+                        return nothing;
+
+                    if (p[i] == '"')
+                        break;
+
+                    char32_t cp;
+                    const size_t n = detail::decode_escape(p + i, size - i, cp);
+                    if (n == 0)
+                        return nothing;
+
+                    has_escapes = true;
+                    i += n;
+                }
+
+                return tuple(drop(i + 1, in), EscapedString{StringView(p + 1, i - 1), has_escapes});
+            }
+
+            // Incomplete until the closing quote, or while an escape could still be completed by more input.
+            // A \u escape may be a high surrogate, which needs the 12 characters of a pair to be decided.
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, EscapedString>
+            {
+                const size_t size = length(in);
+                if (size == 0)
+                    return detail::partial_incomplete<In, EscapedString>();
+
+                const auto res = parse(in);
+                if (res || in[0] != '"')
+                    return detail::partial_decided(res);
+
+                const char *p = in.data();
+
+                size_t i = 1;
+                while (true)
+                {
+                    i = static_cast<size_t>(detail::find_quote_backslash_or_control(p + i, p + size) - p);
+                    if (i == size)
+                        return detail::partial_incomplete<In, EscapedString>();
+
+                    if (detail::is_control(p[i]))
+                        return detail::partial_decided(res);
+
+                    char32_t cp;
+                    const size_t n = detail::decode_escape(p + i, size - i, cp);
+                    if (n == 0)
+                    {
+                        if (size - i < 2 || (p[i + 1] == 'u' && size - i < 12))
+                            return detail::partial_incomplete<In, EscapedString>();
+                        else
+                            return detail::partial_decided(res);
+                    }
+
+                    i += n;
+                }
+            }
+        };
+
+        constexpr EscapedStringParser escaped_string{};
+    }
+}
+
+#if !defined(EFP_PARSER_SEPARATE_COMPILATION)
+#include "impl/escaped_string_parser.ipp"
+#endif
+
+#endif
@@ -0,0 +1,415 @@
+#ifndef EFP_FIXED_FORMAT_PARSER_HPP_
+#define EFP_FIXED_FORMAT_PARSER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include "parser_base.hpp"
+
+// fixed_uint<n>: Parses exactly n decimal digits (n <= 16) with SWAR multiply-adds, 8 digits at once.
+// date_time: Parses "YYYY-MM-DDTHH:MM:SS" with a shuffle and a multiply-add when SSSE3 is available.
+// ipv4: Parses a dotted IPv4 address, validating all the characters at once when SSSE3 is available.
+// The input must expose contiguous data(), e.g. StringView or Cursor.
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            // 8 ASCII digits in a little-endian word, the first digit in the lowest byte
+            constexpr bool swar_digits = true;
+#else
+            constexpr bool swar_digits = false;
+#endif
+
+            inline bool is_eight_digits(uint64_t v)
+            {
+                return ((v & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030) &&
+                       (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030);
+            }
+
+            inline uint32_t eight_digits_value(uint64_t v)
+            {
+                v = ((v & 0x0F0F0F0F0F0F0F0F) * 2561) >> 8;
+                v = ((v & 0x00FF00FF00FF00FF) * 6553601) >> 16;
+                return static_cast<uint32_t>(((v & 0x0000FFFF0000FFFF) * 42949672960001) >> 32);
+            }
+
+            // Value of n <= 8 digits, or false if any is not a digit
+            template <size_t n>
+            bool parse_digits(const char *p, uint32_t &value)
+            {
+                if (swar_digits)
+                {
+                    // Pad with leading '0's up to 8 digits
+                    uint64_t v = 0x3030303030303030;
+                    std::memcpy(reinterpret_cast<char *>(&v) + (8 - n), p, n);
+
+                    if (!is_eight_digits(v))
+                        return false;
+
+                    value = eight_digits_value(v);
+                    return true;
+                }
+                else
+                {
+                    value = 0;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        const auto d = static_cast<unsigned char>(p[i] - '0');
+                        if (d > 9)
+                            return false;
+                        value = value * 10 + d;
+                    }
+                    return true;
+                }
+            }
+
+            constexpr uint64_t pow10(size_t n)
+            {
+                return n == 0 ? 1 : 10 * pow10(n - 1);
+            }
+
+            template <size_t n, bool = (n <= 8)>
+            struct FixedUint
+            {
+                using Type = uint32_t;
+
+                static bool parse(const char *p, Type &value)
+                {
+                    return parse_digits<n>(p, value);
+                }
+            };
+
+            template <size_t n>
+            struct FixedUint<n, false>
+            {
+                using Type = uint64_t;
+
+                static bool parse(const char *p, Type &value)
+                {
+                    uint32_t hi, lo;
+                    if (!parse_digits<n - 8>(p, hi) || !parse_digits<8>(p + n - 8, lo))
+                        return false;
+
+                    value = hi * pow10(8) + lo;
+                    return true;
+                }
+            };
+        }
+
+        // fixed_uint: Parses exactly n decimal digits
+        template <size_t n>
+        struct FixedUintParser : ParserBase<FixedUintParser<n>>
+        {
+            static_assert(n > 0 && n <= 16, "fixed_uint supports 1 to 16 digits.");
+
+            using Out = typename detail::FixedUint<n>::Type;
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, Out>
+            {
+                Out value;
+                if (length(in) >= n && detail::FixedUint<n>::parse(in.data(), value))
+                    return tuple(drop(n, in), value);
+                else
+                    return nothing;
+            }
+        };
+
+        template <size_t n>
+        constexpr FixedUintParser<n> fixed_uint()
+        {
+            return FixedUintParser<n>{};
+        }
+
+        // DateTime
+        // Output of date_time
+
+        struct DateTime
+        {
+            uint16_t year;
+            uint8_t month;
+            uint8_t day;
+            uint8_t hour;
+            uint8_t minute;
+            uint8_t second;
+        };
+
+        // date_time: Parses "YYYY-MM-DDTHH:MM:SS".
+        // Ranges of the fields are checked, but not the number of days of each month.
+        struct DateTimeParser : ParserBase<DateTimeParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, DateTime>
+            {
+                DateTime value;
+                if (length(in) >= 19 && convert(in.data(), value) && is_in_range(value))
+                    return tuple(drop(19, in), value);
+                else
+                    return nothing;
+            }
+
+        private:
+#if defined(__SSSE3__)
+            // Two overlapping loads cover the 19 bytes. The 14 digits are shuffled into one vector,
+            // validated at once, and paired into 2-digit values by a single multiply-add.
+            static bool convert(const char *p, DateTime &value)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 3));
+
+                // Separators at 4, 7, 10, 13 of a, and 16 of the input, 13 of b
+                const __m128i sep_a = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0);
+                const __m128i sep_b = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', 0, 0);
+                const int sep_a_mask = (1 << 4) | (1 << 7) | (1 << 10) | (1 << 13);
+                const int sep_b_mask = 1 << 13;
+
+                if ((_mm_movemask_epi8(_mm_cmpeq_epi8(a, sep_a)) & sep_a_mask) != sep_a_mask ||
+                    (_mm_movemask_epi8(_mm_cmpeq_epi8(b, sep_b)) & sep_b_mask) != sep_b_mask)
+                    return false;
+
+                const __m128i digits = _mm_or_si128(
+                    _mm_shuffle_epi8(a, _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1)),
+                    _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 14, 15, -1, -1)));
+
+                const __m128i zeros = _mm_setr_epi8('0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', 0, 0);
+                const __m128i values = _mm_sub_epi8(digits, zeros);
+
+                const __m128i nines = _mm_set1_epi8(9);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(values, nines), nines)) != 0xFFFF)
+                    return false;
+
+                // YY, YY, MM, DD, hh, mm, ss, 0
+                const __m128i pairs = _mm_maddubs_epi16(values, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+
+                uint16_t fields[8];
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(fields), pairs);
+
+                value.year = static_cast<uint16_t>(fields[0] * 100 + fields[1]);
+                value.month = static_cast<uint8_t>(fields[2]);
+                value.day = static_cast<uint8_t>(fields[3]);
+                value.hour = static_cast<uint8_t>(fields[4]);
+                value.minute = static_cast<uint8_t>(fields[5]);
+                value.second = static_cast<uint8_t>(fields[6]);
+                return true;
+            }
+#else
+            static bool convert(const char *p, DateTime &value)
+            {
+                if (p[4] != '-' || p[7] != '-' || p[10] != 'T' || p[13] != ':' || p[16] != ':')
+                    return false;
+
+                uint32_t year, month, day, hour, minute, second;
+                if (!detail::parse_digits<4>(p, year) ||
+                    !detail::parse_digits<2>(p + 5, month) ||
+                    !detail::parse_digits<2>(p + 8, day) ||
+                    !detail::parse_digits<2>(p + 11, hour) ||
+                    !detail::parse_digits<2>(p + 14, minute) ||
+                    !detail::parse_digits<2>(p + 17, second))
+                    return false;
+
+                value.year = static_cast<uint16_t>(year);
+                value.month = static_cast<uint8_t>(month);
+                value.day = static_cast<uint8_t>(day);
+                value.hour = static_cast<uint8_t>(hour);
+                value.minute = static_cast<uint8_t>(minute);
+                value.second = static_cast<uint8_t>(second);
+                return true;
+            }
+#endif
+
+            static bool is_in_range(const DateTime &value)
+            {
+                return value.month >= 1 && value.month <= 12 &&
+                       value.day >= 1 && value.day <= 31 &&
+                       value.hour <= 23 &&
+                       value.minute <= 59 &&
+                       value.second <= 60;
+            }
+        };
+
+        constexpr DateTimeParser date_time{};
+
+        // ipv4: Parses a dotted IPv4 address into a host order uint32_t.
+        // Octets are 1 to 3 digits without leading zeros, and at most 255.
+        struct Ipv4Parser : ParserBase<Ipv4Parser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, uint32_t>
+            {
+                uint32_t value;
+                const size_t n = convert(in.data(), length(in), value);
+
+                if (n > 0)
+                    return tuple(drop(n, in), value);
+                else
+                    return nothing;
+            }
+
+        private:
+#if defined(__SSSE3__)
+            // Classifies all 16 bytes at once, then gathers the octets by the dot positions
+            // and converts them with one multiply-add.
+            // Returns the length of the address, or 0 if invalid.
+            static size_t convert(const char *p, size_t size, uint32_t &value)
+            {
+                const __m128i v = load(p, size);
+
+                const __m128i values = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+                const __m128i nines = _mm_set1_epi8(9);
+
+                const unsigned digit_mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(values, nines), nines)));
+                const unsigned dot_mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('.'))));
+
+                // The address ends at the first byte which is neither a digit nor a dot
+                const unsigned field_mask = (digit_mask | dot_mask) & 0xFFFF;
+                const size_t n = std::min(static_cast<size_t>(trailing_zeros(~field_mask)), size);
+                if (n > 15)
+                    return 0;
+
+                unsigned dots = dot_mask & ((1u << n) - 1);
+                if (popcount(dots) != 3)
+                    return 0;
+
+                const unsigned e0 = trailing_zeros(dots);
+                dots &= dots - 1;
+                const unsigned e1 = trailing_zeros(dots);
+                dots &= dots - 1;
+                const unsigned e2 = trailing_zeros(dots);
+
+                // Begin and end of each octet, spread over the bytes of its 32-bit lane
+                const __m128i spread = _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12);
+                const __m128i begins = _mm_setr_epi32(0, e0 + 1, e1 + 1, e2 + 1);
+                const __m128i ends = _mm_setr_epi32(e0, e1, e2, static_cast<int>(n));
+                const __m128i lengths = _mm_sub_epi32(ends, begins);
+
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi32(lengths, _mm_set1_epi32(3)),
+                                                   _mm_cmpgt_epi32(_mm_set1_epi32(1), lengths))) != 0)
+                    return 0;
+
+                // Gather each octet right aligned into its lane as 0, hundreds, tens, units
+                const __m128i sources = _mm_add_epi8(_mm_shuffle_epi8(ends, spread), _mm_setr_epi8(-4, -3, -2, -1, -4, -3, -2, -1, -4, -3, -2, -1, -4, -3, -2, -1));
+                const __m128i outside = _mm_cmpgt_epi8(_mm_shuffle_epi8(begins, spread), sources);
+                const __m128i octets = _mm_shuffle_epi8(values, _mm_or_si128(sources, outside));
+
+                const __m128i sums = _mm_madd_epi16(
+                    _mm_maddubs_epi16(octets, _mm_setr_epi8(0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1)),
+                    _mm_set1_epi16(1));
+
+                // Over 255, or less than the smallest value without a leading zero for the length
+                const __m128i minimums = _mm_shuffle_epi8(_mm_setr_epi8(0, 0, 10, 100, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0), lengths);
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpgt_epi32(sums, _mm_set1_epi32(255)),
+                                                   _mm_cmpgt_epi32(minimums, sums))) != 0)
+                    return 0;
+
+                value = static_cast<uint32_t>(_mm_cvtsi128_si32(
+                    _mm_shuffle_epi8(sums, _mm_setr_epi8(12, 8, 4, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1))));
+                return n;
+            }
+
+            // Loads up to 16 bytes without reading past the input, zero filled
+            static __m128i load(const char *p, size_t size)
+            {
+                if (size >= 16)
+                    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+
+                if (size >= 8)
+                {
+                    // Two overlapping 8-byte loads, with the tail shuffled into place
+                    const __m128i halves = _mm_unpacklo_epi64(
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)),
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + size - 8)));
+
+                    const __m128i iota = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+                    const __m128i tail = _mm_cmpgt_epi8(iota, _mm_set1_epi8(7));
+                    const __m128i past = _mm_cmpgt_epi8(iota, _mm_set1_epi8(static_cast<char>(size - 1)));
+                    const __m128i indices = _mm_add_epi8(iota, _mm_and_si128(tail, _mm_set1_epi8(static_cast<char>(16 - size))));
+
+                    return _mm_shuffle_epi8(halves, _mm_or_si128(indices, past));
+                }
+
+                char buffer[16] = {};
+                std::memcpy(buffer, p, size);
+                return _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer));
+            }
+
+            static unsigned trailing_zeros(unsigned mask)
+            {
+                return static_cast<unsigned>(__builtin_ctz(mask));
+            }
+
+            static int popcount(unsigned mask)
+            {
+                return __builtin_popcount(mask);
+            }
+#else
+            // Value of the octet digits [begin, end), or more than 255 if invalid.
+            // Branch free, as the octet lengths vary from address to address.
+            // digits must have three readable bytes before the first one, as an empty octet reads the three before it.
+            static uint32_t octet(const uint8_t *digits, size_t begin, size_t end)
+            {
+                const size_t n = end - begin;
+                const uint32_t value = digits[end - 1] +
+                                       (n >= 2) * 10u * digits[end - 2] +
+                                       (n >= 3) * 100u * digits[end - 3];
+                const bool valid = (n - 1 < 3) & !((n > 1) & (digits[begin] == 0));
+
+                return valid ? value : 256;
+            }
+
+            static size_t convert(const char *p, size_t size, uint32_t &value)
+            {
+                uint8_t padded[19] = {};
+                uint8_t *digits = padded + 3;
+                size_t dots[3];
+                size_t dot_count = 0;
+                size_t n = 0;
+
+                while (n < size && n < 16)
+                {
+                    const auto d = static_cast<unsigned char>(p[n] - '0');
+                    if (d <= 9)
+                        digits[n] = d;
+                    else if (p[n] != '.')
+                        break;
+                    else if (dot_count < 3)
+                        dots[dot_count++] = n;
+                    else
+                        return 0;
+                    ++n;
+                }
+
+                if (n > 15 || dot_count != 3)
+                    return 0;
+
+                size_t begin = 0;
+                value = 0;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const size_t end = i < 3 ? dots[i] : n;
+                    const uint32_t o = octet(digits, begin, end);
+                    if (o > 255)
+                        return 0;
+
+                    value = (value << 8) | o;
+                    begin = end + 1;
+                }
+
+                return n;
+            }
+#endif
+        };
+
+        constexpr Ipv4Parser ipv4{};
+    }
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef EFP_ESCAPED_STRING_PARSER_IPP_
+#define EFP_ESCAPED_STRING_PARSER_IPP_
+
+#include <cstring>
+
+#include "../escaped_string_parser.hpp"
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+            // Value of 4 hex digits, or -1
+            inline long hex4(const char *p)
+            {
+                long value = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const char c = p[i];
+                    int d;
+                    if (c >= '0' && c <= '9')
+                        d = c - '0';
+                    else if (c >= 'a' && c <= 'f')
+                        d = c - 'a' + 10;
+                    else if (c >= 'A' && c <= 'F')
+                        d = c - 'A' + 10;
+                    else
+                        return -1;
+                    value = value * 16 + d;
+                }
+                return value;
+            }
+
+            // Decodes the escape sequence at p, which starts with a backslash.
+            // Returns its length, or 0 if it is invalid or truncated.
+            EFP_PARSER_DECL size_t decode_escape(const char *p, size_t size, char32_t &cp)
+            {
+                if (size < 2)
+                    return 0;
+
+                switch (p[1])
+                {
+                case '"':
+                    cp = '"';
+                    return 2;
+                case '\\':
+                    cp = '\\';
+                    return 2;
+                case '/':
+                    cp = '/';
+                    return 2;
+                case 'b':
+                    cp = '\b';
+                    return 2;
+                case 'f':
+                    cp = '\f';
+                    return 2;
+                case 'n':
+                    cp = '\n';
+                    return 2;
+                case 'r':
+                    cp = '\r';
+                    return 2;
+                case 't':
+                    cp = '\t';
+                    return 2;
+                case 'u':
+                    break;
+                default:
+                    return 0;
+                }
+
+                if (size < 6)
+                    return 0;
+
+                const long high = hex4(p + 2);
+                if (high < 0 || (high >= 0xDC00 && high <= 0xDFFF))
+                    return 0;
+
+                if (high < 0xD800 || high > 0xDBFF)
+                {
+                    cp = static_cast<char32_t>(high);
+                    return 6;
+                }
+
+                // Surrogate pair
+                if (size < 12 || p[6] != '\\' || p[7] != 'u')
+                    return 0;
+
+                const long low = hex4(p + 8);
+                if (low < 0xDC00 || low > 0xDFFF)
+                    return 0;
+
+                cp = static_cast<char32_t>(0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00));
+                return 12;
+            }
+
+            EFP_PARSER_DECL size_t encode_utf8(char32_t cp, char *out)
+            {
+                if (cp < 0x80)
+                {
+                    out[0] = static_cast<char>(cp);
+                    return 1;
+                }
+                else if (cp < 0x800)
+                {
+                    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+                    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                    return 2;
+                }
+                else if (cp < 0x10000)
+                {
+                    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+                    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                    return 3;
+                }
+                else
+                {
+                    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+                    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+                    return 4;
+                }
+            }
+        }
+
+        EFP_PARSER_DECL size_t EscapedString::unescape(char *out) const
+        {
+            const char *p = raw.data();
+            const char *end = p + raw.size();
+
+            size_t n = 0;
+            while (p != end)
+            {
+                const char *run_end = detail::find_quote_backslash_or_control(p, end);
+                const size_t run = static_cast<size_t>(run_end - p);
+                std::memcpy(out + n, p, run);
+                p = run_end;
+                n += run;
+
+                if (p != end)
+                {
+                    // Never left in raw by the parser, but raw could be set by hand
+                    char32_t cp = 0;
+                    const size_t escape = *p == '\\' ? detail::decode_escape(p, static_cast<size_t>(end - p), cp) : 0;
+                    if (escape == 0)
+                        break;
+
+                    p += escape;
+                    n += detail::encode_utf8(cp, out + n);
+                }
+            }
+            return n;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef EFP_JSON_PARSER_IPP_
+#define EFP_JSON_PARSER_IPP_
+
+#include "../json_parser.hpp"
+
+namespace efp
+{
+    namespace parser
+    {
+        EFP_PARSER_DECL Maybe<JsonValue> json_dom(const StringView &in, JsonArena &arena, size_t max_depth)
+        {
+            JsonDomBuilder builder(arena);
+
+            if (json_sax(in, builder, max_depth))
+                return builder.root();
+            else
+                return nothing;
+        }
+    }
+}
+
+#endif
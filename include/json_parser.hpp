@@ -0,0 +1,678 @@
+#ifndef EFP_JSON_PARSER_HPP_
+#define EFP_JSON_PARSER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+// Reference JSON parser, built from the combinators of this library.
+// json_number: Parses a JSON number as double.
+// json_sax: Parses a whole JSON document and reports it to a handler as SAX events, with no virtual call.
+// json_dom: Parses a whole JSON document into JsonValue nodes allocated in a JsonArena.
+// Strings without escapes are views of the input, which must outlive the results.
+
+// A handler provides
+//     void null();
+//     void boolean(bool);
+//     void number(double);
+//     void string(const EscapedString &);
+//     void key(const EscapedString &);
+//     void start_object();
+//     void end_object();
+//     void start_array();
+//     void end_array();
+// Events are reported as soon as they are parsed, so an invalid document may leave a partial sequence of them.
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+            // Exact powers of 10 as double
+            inline double exact_pow10(int n)
+            {
+                static const double table[] = {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+                return table[n];
+            }
+
+            // Whitespace between JSON tokens
+            struct JsonWhitespaceParser : ParserBase<JsonWhitespaceParser>
+            {
+                template <typename In>
+                auto parse(const In &in) const -> Parsed<In, Skipped>
+                {
+                    size_t i = 0;
+                    while (i < length(in) && (in[i] == ' ' || in[i] == '\n' || in[i] == '\r' || in[i] == '\t'))
+                    {
+                        ++i;
+                    }
+                    return tuple(drop(i, in), Skipped{});
+                }
+            };
+
+            constexpr JsonWhitespaceParser json_whitespace{};
+
+            // Events of the handler
+
+            struct JsonNullEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.null();
+                }
+            };
+
+            struct JsonTrueEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.boolean(true);
+                }
+            };
+
+            struct JsonFalseEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.boolean(false);
+                }
+            };
+
+            struct JsonNumberEvent
+            {
+                template <typename Handler>
+                static void emit(Handler &handler, double value)
+                {
+                    handler.number(value);
+                }
+            };
+
+            struct JsonStringEvent
+            {
+                template <typename Handler>
+                static void emit(Handler &handler, const EscapedString &value)
+                {
+                    handler.string(value);
+                }
+            };
+
+            struct JsonKeyEvent
+            {
+                template <typename Handler>
+                static void emit(Handler &handler, const EscapedString &value)
+                {
+                    handler.key(value);
+                }
+            };
+
+            struct JsonStartObjectEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.start_object();
+                }
+            };
+
+            struct JsonEndObjectEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.end_object();
+                }
+            };
+
+            struct JsonStartArrayEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.start_array();
+                }
+            };
+
+            struct JsonEndArrayEvent
+            {
+                template <typename Handler, typename A>
+                static void emit(Handler &handler, const A &)
+                {
+                    handler.end_array();
+                }
+            };
+
+            // Runs p, and reports its output to the handler on success
+            template <typename Event, typename P, typename Handler>
+            struct JsonEmitParser : ParserBase<JsonEmitParser<Event, P, Handler>>
+            {
+                P p;
+                Handler *handler;
+
+                JsonEmitParser(const P &p, Handler *handler)
+                    : p(p), handler(handler) {}
+
+                template <typename In>
+                auto parse(const In &in) const -> Parsed<In, Skipped>
+                {
+                    const auto res = p(in);
+                    if (!res)
+                        return nothing;
+
+                    Event::emit(*handler, snd(res.value()));
+                    return tuple(fst(res.value()), Skipped{});
+                }
+            };
+
+            template <typename Event, typename P, typename Handler>
+            auto json_emit(const P &p, Handler &handler)
+                -> JsonEmitParser<Event, FuncToFuncPtr<P>, Handler>
+            {
+                return JsonEmitParser<Event, FuncToFuncPtr<P>, Handler>(p, &handler);
+            }
+
+            // Runs p one level deeper into the nesting, and fails beyond the maximum depth
+            template <typename P>
+            struct JsonNestParser : ParserBase<JsonNestParser<P>>
+            {
+                P p;
+                size_t *depth;
+                size_t max_depth;
+
+                JsonNestParser(const P &p, size_t *depth, size_t max_depth)
+                    : p(p), depth(depth), max_depth(max_depth) {}
+
+                template <typename In>
+                auto parse(const In &in) const -> Parsed<In, CallParserO<P, In>>
+                {
+                    if (*depth >= max_depth)
+                        return nothing;
+
+                    // Restored as well if the handler throws
+                    struct Level
+                    {
+                        size_t *depth;
+
+                        ~Level()
+                        {
+                            --*depth;
+                        }
+                    };
+
+                    ++*depth;
+                    const Level level{depth};
+                    return p(in);
+                }
+            };
+
+            template <typename P>
+            auto json_nest(const P &p, size_t *depth, size_t max_depth)
+                -> JsonNestParser<FuncToFuncPtr<P>>
+            {
+                return JsonNestParser<FuncToFuncPtr<P>>(p, depth, max_depth);
+            }
+        }
+
+        // json_number: Parses a JSON number.
+        // Up to 19 significant digits with a small exponent are converted exactly without strtod.
+        struct JsonNumberParser : ParserBase<JsonNumberParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, double>
+            {
+                const char *p = in.data();
+                const size_t size = length(in);
+
+                size_t i = 0;
+                const bool negative = i < size && p[i] == '-';
+                if (negative)
+                    ++i;
+
+                uint64_t mantissa = 0;
+                int digits = 0;
+                int exponent = 0;
+
+                if (i < size && p[i] == '0')
+                {
+                    ++i;
+                }
+                else if (i < size && detail::is_digit(p[i]))
+                {
+                    while (i < size && detail::is_digit(p[i]))
+                    {
+                        accumulate(p[i], mantissa, digits, exponent);
+                        ++i;
+                    }
+                }
+                else
+                {
+                    return nothing;
+                }
+
+                if (i < size && p[i] == '.')
+                {
+                    ++i;
+                    if (i == size || !detail::is_digit(p[i]))
+                        return nothing;
+
+                    while (i < size && detail::is_digit(p[i]))
+                    {
+                        accumulate(p[i], mantissa, digits, exponent);
+                        --exponent;
+                        ++i;
+                    }
+                }
+
+                if (i < size && (p[i] == 'e' || p[i] == 'E'))
+                {
+                    ++i;
+                    const bool negative_exponent = i < size && p[i] == '-';
+                    if (i < size && (p[i] == '-' || p[i] == '+'))
+                        ++i;
+                    if (i == size || !detail::is_digit(p[i]))
+                        return nothing;
+
+                    int e = 0;
+                    while (i < size && detail::is_digit(p[i]))
+                    {
+                        if (e < 100000)
+                            e = e * 10 + (p[i] - '0');
+                        ++i;
+                    }
+                    exponent += negative_exponent ? -e : e;
+                }
+
+                double value;
+                if (digits <= 19 && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+                {
+                    value = static_cast<double>(mantissa);
+                    value = exponent < 0 ? value / detail::exact_pow10(-exponent) : value * detail::exact_pow10(exponent);
+                    if (negative)
+                        value = -value;
+                }
+                else
+                {
+                    value = slow_path(p, i);
+                }
+
+                return tuple(drop(i, in), value);
+            }
+
+            // Only the syntax is checked, and nothing is converted
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                const char *p = in.data();
+                const size_t size = length(in);
+
+                size_t i = size > 0 && p[0] == '-' ? 1 : 0;
+
+                if (i < size && p[i] == '0')
+                    ++i;
+                else if (i < size && detail::is_digit(p[i]))
+                    i = skip_digits(p, size, i);
+                else
+                    return nothing;
+
+                if (i < size && p[i] == '.')
+                {
+                    ++i;
+                    if (i == size || !detail::is_digit(p[i]))
+                        return nothing;
+
+                    i = skip_digits(p, size, i);
+                }
+
+                if (i < size && (p[i] == 'e' || p[i] == 'E'))
+                {
+                    ++i;
+                    if (i < size && (p[i] == '-' || p[i] == '+'))
+                        ++i;
+                    if (i == size || !detail::is_digit(p[i]))
+                        return nothing;
+
+                    i = skip_digits(p, size, i);
+                }
+
+                return drop(i, in);
+            }
+
+        private:
+            static size_t skip_digits(const char *p, size_t size, size_t i)
+            {
+                while (i < size && detail::is_digit(p[i]))
+                    ++i;
+                return i;
+            }
+
+            // Significant digits go to the mantissa, the ones beyond 19 only scale it
+            static void accumulate(char c, uint64_t &mantissa, int &digits, int &exponent)
+            {
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+                    if (mantissa != 0)
+                        ++digits;
+                }
+                else
+                {
+                    ++digits;
+                    ++exponent;
+                }
+            }
+
+            static double slow_path(const char *p, size_t n)
+            {
+                char buffer[64];
+                if (n < sizeof(buffer))
+                {
+                    std::memcpy(buffer, p, n);
+                    buffer[n] = '\0';
+                    return std::strtod(buffer, nullptr);
+                }
+                else
+                {
+                    return std::strtod(std::string(p, n).c_str(), nullptr);
+                }
+            }
+        };
+
+        constexpr JsonNumberParser json_number{};
+
+        // Default maximum depth of the nested arrays and objects, well within the stack of a thread
+        constexpr size_t json_max_depth = 256;
+
+        namespace detail
+        {
+            // JsonParser
+            // Parses a JSON value with the surrounding whitespace, and reports it to the handler.
+            // The grammar holds a Rule for the recursion, so a JsonParser is constructed in place and not copied.
+            // Arrays and objects nested deeper than max_depth fail the parse, so that untrusted input could not exhaust
+            // the stack. The depth is counted while parsing, so unlike the parsers of this library a JsonParser is not
+            // shared. json_sax constructs one per document instead.
+
+            template <typename Handler, typename In = StringView>
+            class JsonParser : public ParserBase<JsonParser<Handler, In>>
+            {
+            public:
+                explicit JsonParser(Handler &handler, size_t max_depth = json_max_depth)
+                    : depth_(0)
+                {
+                    const auto value = ref(value_);
+                    const auto ws = json_whitespace;
+
+                    const auto array = tpl(json_emit<JsonStartArrayEvent>(ch('['), handler),
+                                           ws,
+                                           separated0(ch(','), value),
+                                           json_emit<JsonEndArrayEvent>(ch(']'), handler));
+
+                    const auto member = tpl(ws,
+                                            json_emit<JsonKeyEvent>(escaped_string, handler),
+                                            ws,
+                                            ch(':'),
+                                            value);
+
+                    const auto object = tpl(json_emit<JsonStartObjectEvent>(ch('{'), handler),
+                                            ws,
+                                            separated0(ch(','), member),
+                                            json_emit<JsonEndObjectEvent>(ch('}'), handler));
+
+                    value_ = delimited(ws,
+                                       alt(json_emit<JsonStringEvent>(escaped_string, handler),
+                                           json_emit<JsonNumberEvent>(json_number, handler),
+                                           json_nest(skip(object), &depth_, max_depth),
+                                           json_nest(skip(array), &depth_, max_depth),
+                                           json_emit<JsonTrueEvent>(tag("true"), handler),
+                                           json_emit<JsonFalseEvent>(tag("false"), handler),
+                                           json_emit<JsonNullEvent>(tag("null"), handler)),
+                                       ws);
+                }
+
+                auto parse(const In &in) const -> Parsed<In, Skipped>
+                {
+                    return value_(in);
+                }
+
+            private:
+                size_t depth_;
+                Rule<In, Skipped, 512> value_;
+            };
+        }
+
+        // json_sax: Parses a whole JSON document, true if it is valid
+        template <typename Handler>
+        bool json_sax(const StringView &in, Handler &handler, size_t max_depth = json_max_depth)
+        {
+            const detail::JsonParser<Handler> json(handler, max_depth);
+            const auto res = json(in);
+
+            return res && length(fst(res.value())) == 0;
+        }
+
+        // JsonArena
+        // Bump allocator of the JSON nodes and unescaped strings, freed all at once
+
+        class JsonArena
+        {
+        public:
+            explicit JsonArena(size_t block_size = 64 * 1024)
+                : current_(nullptr), left_(0), block_size_(block_size) {}
+
+            JsonArena(const JsonArena &) = delete;
+            JsonArena &operator=(const JsonArena &) = delete;
+
+            template <typename A>
+            A *allocate(size_t n)
+            {
+                const size_t size = n * sizeof(A);
+                const size_t padding = (alignof(A) - reinterpret_cast<uintptr_t>(current_) % alignof(A)) % alignof(A);
+
+                if (padding + size > left_)
+                {
+                    const size_t block_size = size + alignof(A) > block_size_ ? size + alignof(A) : block_size_;
+                    blocks_.emplace_back(new char[block_size]);
+                    current_ = blocks_.back().get();
+                    left_ = block_size;
+                    return allocate<A>(n);
+                }
+
+                A *result = reinterpret_cast<A *>(current_ + padding);
+                current_ += padding + size;
+                left_ -= padding + size;
+                return result;
+            }
+
+        private:
+            std::vector<std::unique_ptr<char[]>> blocks_;
+            char *current_;
+            size_t left_;
+            size_t block_size_;
+        };
+
+        enum class JsonType
+        {
+            Null,
+            Boolean,
+            Number,
+            String,
+            Array,
+            Object,
+        };
+
+        // JsonValue
+        // DOM node. The elements of an array or the members of an object are contiguous in the arena,
+        // and each member carries its key.
+
+        struct JsonValue
+        {
+            JsonType type;
+            bool boolean;
+            double number;
+            StringView string;
+            StringView key;
+            const JsonValue *children;
+            size_t size;
+
+            const JsonValue &operator[](size_t i) const
+            {
+                return children[i];
+            }
+
+            // Member of an object by key, or nullptr
+            const JsonValue *find(const StringView &k) const
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (children[i].key == k)
+                        return &children[i];
+                }
+                return nullptr;
+            }
+        };
+
+        // JsonDomBuilder
+        // Handler which builds JsonValue nodes in an arena
+
+        class JsonDomBuilder
+        {
+        public:
+            explicit JsonDomBuilder(JsonArena &arena)
+                : arena_(arena) {}
+
+            void null()
+            {
+                push(value_of(JsonType::Null));
+            }
+
+            void boolean(bool b)
+            {
+                JsonValue v = value_of(JsonType::Boolean);
+                v.boolean = b;
+                push(v);
+            }
+
+            void number(double n)
+            {
+                JsonValue v = value_of(JsonType::Number);
+                v.number = n;
+                push(v);
+            }
+
+            void string(const EscapedString &s)
+            {
+                JsonValue v = value_of(JsonType::String);
+                v.string = text(s);
+                push(v);
+            }
+
+            void key(const EscapedString &s)
+            {
+                key_ = text(s);
+            }
+
+            void start_object()
+            {
+                start(JsonType::Object);
+            }
+
+            void end_object()
+            {
+                end();
+            }
+
+            void start_array()
+            {
+                start(JsonType::Array);
+            }
+
+            void end_array()
+            {
+                end();
+            }
+
+            const JsonValue &root() const
+            {
+                return values_.front();
+            }
+
+        private:
+            struct Frame
+            {
+                size_t begin;
+                JsonValue container;
+            };
+
+            static JsonValue value_of(JsonType type)
+            {
+                return JsonValue{type, false, 0., StringView(), StringView(), nullptr, 0};
+            }
+
+            void push(JsonValue v)
+            {
+                v.key = key_;
+                key_ = StringView();
+                values_.push_back(v);
+            }
+
+            void start(JsonType type)
+            {
+                JsonValue container = value_of(type);
+                container.key = key_;
+                key_ = StringView();
+                frames_.push_back(Frame{values_.size(), container});
+            }
+
+            // Moves the children, which are on top of the stack, into the arena
+            void end()
+            {
+                const Frame frame = frames_.back();
+                frames_.pop_back();
+
+                const size_t n = values_.size() - frame.begin;
+                JsonValue *children = arena_.allocate<JsonValue>(n);
+                std::copy(values_.begin() + frame.begin, values_.end(), children);
+                values_.resize(frame.begin);
+
+                JsonValue container = frame.container;
+                container.children = children;
+                container.size = n;
+                values_.push_back(container);
+            }
+
+            StringView text(const EscapedString &s)
+            {
+                if (!s.has_escapes)
+                    return s.raw;
+
+                char *buffer = arena_.allocate<char>(s.raw.size());
+                return StringView(buffer, s.unescape(buffer));
+            }
+
+            JsonArena &arena_;
+            std::vector<JsonValue> values_;
+            std::vector<Frame> frames_;
+            StringView key_;
+        };
+
+        // json_dom: Parses a whole JSON document into the arena
+        EFP_PARSER_DECL Maybe<JsonValue> json_dom(const StringView &in, JsonArena &arena,
+                                                  size_t max_depth = json_max_depth);
+    }
+}
+
+#if !defined(EFP_PARSER_SEPARATE_COMPILATION)
+#include "impl/json_parser.ipp"
+#endif
+
+#endif
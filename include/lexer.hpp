@@ -0,0 +1,682 @@
+#ifndef EFP_LEXER_HPP_
+#define EFP_LEXER_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "parser_base.hpp"
+#include "character_parser.hpp"
+#include "bytes_parser.hpp"
+#include "parser_combinator.hpp"
+
+// lexer: Compiles token definitions into a minimized DFA with a dense transition table.
+// Token definitions are the existing parsers: ch, tag, one_of, none_of, satisfy, anychar, crlf, tab, newline, line_ending,
+// the run parsers, not_line_ending, and tpl, alt, skip, preceded, terminated and delimited of them.
+// The kind of a token is the index of its definition. The longest match wins, and the earlier definition wins a tie.
+// lexeme: Matches a Lexeme of the given kind, to parse the token stream with the combinators.
+
+namespace efp
+{
+    namespace parser
+    {
+        // Lexeme
+        // Token kind and the matched slice of the input
+
+        template <typename In>
+        struct Lexeme
+        {
+            size_t kind;
+            In text;
+        };
+
+        namespace detail
+        {
+            // No state, or no token kind
+            const size_t npos = static_cast<size_t>(-1);
+
+            // Thompson NFA of the token definitions
+            class Nfa
+            {
+            public:
+                struct State
+                {
+                    CharSet set;
+                    size_t next; // Target of the set edge, or npos
+                    std::vector<size_t> eps;
+                    size_t kind; // Accepted token kind, or npos
+                };
+
+                struct Fragment
+                {
+                    size_t start;
+                    size_t end;
+                };
+
+                Nfa()
+                {
+                    start_ = add_state();
+                }
+
+                Fragment chars(const CharSet &set)
+                {
+                    const size_t s = add_state();
+                    const size_t e = add_state();
+                    states_[s].set = set;
+                    states_[s].next = e;
+                    return Fragment{s, e};
+                }
+
+                Fragment literal(const StringView &t)
+                {
+                    Fragment res = empty();
+                    for (size_t i = 0; i < length(t); ++i)
+                    {
+                        CharSet set;
+                        set.insert(static_cast<unsigned char>(t[i]));
+                        res = cat(res, chars(set));
+                    }
+                    return res;
+                }
+
+                Fragment empty()
+                {
+                    const size_t s = add_state();
+                    const size_t e = add_state();
+                    states_[s].eps.push_back(e);
+                    return Fragment{s, e};
+                }
+
+                Fragment cat(const Fragment &a, const Fragment &b)
+                {
+                    states_[a.end].eps.push_back(b.start);
+                    return Fragment{a.start, b.end};
+                }
+
+                Fragment alt(const Fragment &a, const Fragment &b)
+                {
+                    const size_t s = add_state();
+                    const size_t e = add_state();
+                    states_[s].eps.push_back(a.start);
+                    states_[s].eps.push_back(b.start);
+                    states_[a.end].eps.push_back(e);
+                    states_[b.end].eps.push_back(e);
+                    return Fragment{s, e};
+                }
+
+                Fragment star(const Fragment &a)
+                {
+                    const size_t s = add_state();
+                    const size_t e = add_state();
+                    states_[s].eps.push_back(a.start);
+                    states_[s].eps.push_back(e);
+                    states_[a.end].eps.push_back(a.start);
+                    states_[a.end].eps.push_back(e);
+                    return Fragment{s, e};
+                }
+
+                Fragment plus(const Fragment &a)
+                {
+                    const size_t s = add_state();
+                    const size_t e = add_state();
+                    states_[s].eps.push_back(a.start);
+                    states_[a.end].eps.push_back(a.start);
+                    states_[a.end].eps.push_back(e);
+                    return Fragment{s, e};
+                }
+
+                void add_token(const Fragment &f, size_t kind)
+                {
+                    states_[start_].eps.push_back(f.start);
+                    states_[f.end].kind = kind;
+                }
+
+                size_t start() const
+                {
+                    return start_;
+                }
+
+                const std::vector<State> &states() const
+                {
+                    return states_;
+                }
+
+            private:
+                size_t add_state()
+                {
+                    states_.push_back(State{CharSet(), npos, std::vector<size_t>(), npos});
+                    return states_.size() - 1;
+                }
+
+                size_t start_;
+                std::vector<State> states_;
+            };
+
+            // Token definitions to NFA fragments.
+            // Found by ADL on Nfa, so the definitions may nest in any order.
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const ChParser &p)
+            {
+                CharSet set;
+                set.insert(static_cast<unsigned char>(p.c));
+                return nfa.chars(set);
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Tag<StringView> &p)
+            {
+                return nfa.literal(p.t);
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const OneOfParser &p)
+            {
+                return nfa.chars(p.set);
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const NoneOfParser &p)
+            {
+                return nfa.chars(CharSet::of([&](char c)
+                                             { return !p.set.contains(static_cast<unsigned char>(c)); }));
+            }
+
+            template <typename Predicate>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const SatisfyParser<Predicate> &p)
+            {
+                return nfa.chars(CharSet::of(p.pred));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const AnyCharParser &)
+            {
+                return nfa.chars(CharSet::of([](char)
+                                             { return true; }));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const CrlfParser &)
+            {
+                return nfa.literal("\r\n");
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const TabParser &)
+            {
+                return nfa.literal("\t");
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const NewlineParser &)
+            {
+                return nfa.literal("\n");
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const LineEndingParser &)
+            {
+                return nfa.alt(nfa.literal("\r\n"), nfa.literal("\n"));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const NotLineEndingParser &)
+            {
+                return nfa.plus(nfa.chars(CharSet::of(is_not_line_ending)));
+            }
+
+            inline CharSet alpha_set()
+            {
+                return CharSet::of(is_alpha);
+            }
+
+            inline CharSet alphanumeric_set()
+            {
+                return CharSet::of(is_alnum);
+            }
+
+            inline CharSet digit_set()
+            {
+                return CharSet::of(is_digit);
+            }
+
+            inline CharSet hex_digit_set()
+            {
+                return CharSet::of(is_hex_digit);
+            }
+
+            inline CharSet oct_digit_set()
+            {
+                return CharSet::of(is_oct_digit);
+            }
+
+            inline CharSet multispace_set()
+            {
+                return CharSet::of(is_space);
+            }
+
+            inline CharSet space_set()
+            {
+                return CharSet::of(is_blank_space);
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Alpha0Parser &)
+            {
+                return nfa.star(nfa.chars(alpha_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Alpha1Parser &)
+            {
+                return nfa.plus(nfa.chars(alpha_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Alphanumeric0Parser &)
+            {
+                return nfa.star(nfa.chars(alphanumeric_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Alphanumeric1Parser &)
+            {
+                return nfa.plus(nfa.chars(alphanumeric_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Digit0Parser &)
+            {
+                return nfa.star(nfa.chars(digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Digit1Parser &)
+            {
+                return nfa.plus(nfa.chars(digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const HexDigit0Parser &)
+            {
+                return nfa.star(nfa.chars(hex_digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const HexDigit1Parser &)
+            {
+                return nfa.plus(nfa.chars(hex_digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const OctDigit0Parser &)
+            {
+                return nfa.star(nfa.chars(oct_digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const OctDigit1Parser &)
+            {
+                return nfa.plus(nfa.chars(oct_digit_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Multispace0Parser &)
+            {
+                return nfa.star(nfa.chars(multispace_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Multispace1Parser &)
+            {
+                return nfa.plus(nfa.chars(multispace_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Space0Parser &)
+            {
+                return nfa.star(nfa.chars(space_set()));
+            }
+
+            inline Nfa::Fragment lex_pattern(Nfa &nfa, const Space1Parser &)
+            {
+                return nfa.plus(nfa.chars(space_set()));
+            }
+
+            template <typename P>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const SkipParser<P> &p)
+            {
+                return lex_pattern(nfa, p.p);
+            }
+
+            template <typename P1, typename P2>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const PrecededParser<P1, P2> &p)
+            {
+                const auto a = lex_pattern(nfa, p.p1);
+                return nfa.cat(a, lex_pattern(nfa, p.p2));
+            }
+
+            template <typename P1, typename P2>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const TerminatedParser<P1, P2> &p)
+            {
+                const auto a = lex_pattern(nfa, p.p1);
+                return nfa.cat(a, lex_pattern(nfa, p.p2));
+            }
+
+            template <typename P1, typename P2, typename P3>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const DelimitedParser<P1, P2, P3> &p)
+            {
+                const auto a = lex_pattern(nfa, p.p1);
+                const auto b = lex_pattern(nfa, p.p2);
+                return nfa.cat(nfa.cat(a, b), lex_pattern(nfa, p.p3));
+            }
+
+            template <size_t n, typename... Ps>
+            auto lex_cat(Nfa &nfa, const Tuple<Ps...> &ps)
+                -> EnableIf<(n + 1 == sizeof...(Ps)), Nfa::Fragment>
+            {
+                return lex_pattern(nfa, get<n>(ps));
+            }
+
+            template <size_t n, typename... Ps>
+            auto lex_cat(Nfa &nfa, const Tuple<Ps...> &ps)
+                -> EnableIf<(n + 1 < sizeof...(Ps)), Nfa::Fragment>
+            {
+                const auto a = lex_pattern(nfa, get<n>(ps));
+                return nfa.cat(a, lex_cat<n + 1>(nfa, ps));
+            }
+
+            template <size_t n, typename... Ps>
+            auto lex_alt(Nfa &nfa, const Tuple<Ps...> &ps)
+                -> EnableIf<(n + 1 == sizeof...(Ps)), Nfa::Fragment>
+            {
+                return lex_pattern(nfa, get<n>(ps));
+            }
+
+            template <size_t n, typename... Ps>
+            auto lex_alt(Nfa &nfa, const Tuple<Ps...> &ps)
+                -> EnableIf<(n + 1 < sizeof...(Ps)), Nfa::Fragment>
+            {
+                const auto a = lex_pattern(nfa, get<n>(ps));
+                return nfa.alt(a, lex_alt<n + 1>(nfa, ps));
+            }
+
+            template <typename... Ps>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const TupleParser<Ps...> &p)
+            {
+                return lex_cat<0>(nfa, p.ps);
+            }
+
+            template <typename... Ps>
+            Nfa::Fragment lex_pattern(Nfa &nfa, const AltParser<Ps...> &p)
+            {
+                return lex_alt<0>(nfa, p.ps);
+            }
+
+            template <size_t n, typename... Ps>
+            auto add_tokens(Nfa &, const Tuple<Ps...> &)
+                -> EnableIf<(n == sizeof...(Ps)), void>
+            {
+            }
+
+            template <size_t n, typename... Ps>
+            auto add_tokens(Nfa &nfa, const Tuple<Ps...> &ps)
+                -> EnableIf<(n < sizeof...(Ps)), void>
+            {
+                nfa.add_token(lex_pattern(nfa, get<n>(ps)), n);
+                add_tokens<n + 1>(nfa, ps);
+            }
+        }
+
+        // Lexer
+        // Minimized DFA over byte equivalence classes, with a dense transition table
+
+        class Lexer : public ParserBase<Lexer>
+        {
+        public:
+            explicit Lexer(const detail::Nfa &nfa)
+            {
+                const auto &nfa_states = nfa.states();
+
+                // Bytes which no edge distinguishes share a class
+                std::map<std::vector<bool>, uint8_t> class_ids;
+                std::vector<unsigned char> representatives;
+                for (int c = 0; c < 256; ++c)
+                {
+                    std::vector<bool> signature;
+                    for (const auto &s : nfa_states)
+                    {
+                        if (s.next != detail::npos)
+                            signature.push_back(s.set.contains(static_cast<unsigned char>(c)));
+                    }
+
+                    const auto it = class_ids.find(signature);
+                    if (it != class_ids.end())
+                    {
+                        class_of_[c] = it->second;
+                    }
+                    else
+                    {
+                        const auto id = static_cast<uint8_t>(representatives.size());
+                        class_ids[signature] = id;
+                        class_of_[c] = id;
+                        representatives.push_back(static_cast<unsigned char>(c));
+                    }
+                }
+                class_count_ = representatives.size();
+
+                // Subset construction. The empty set is the dead state 0.
+                std::map<std::vector<size_t>, size_t> dfa_ids;
+                std::vector<std::vector<size_t>> dfa_states;
+                std::vector<size_t> table;
+                std::vector<size_t> accept;
+
+                const auto add_dfa_state = [&](const std::vector<size_t> &set) -> size_t
+                {
+                    const auto it = dfa_ids.find(set);
+                    if (it != dfa_ids.end())
+                        return it->second;
+
+                    size_t kind = detail::npos;
+                    for (const auto s : set)
+                        kind = std::min(kind, nfa_states[s].kind);
+
+                    dfa_ids[set] = dfa_states.size();
+                    dfa_states.push_back(set);
+                    accept.push_back(kind);
+                    return dfa_states.size() - 1;
+                };
+
+                add_dfa_state(std::vector<size_t>());
+                const size_t start = add_dfa_state(closure(nfa, std::vector<size_t>(1, nfa.start())));
+
+                for (size_t i = 0; i < dfa_states.size(); ++i)
+                {
+                    for (size_t k = 0; k < class_count_; ++k)
+                    {
+                        std::vector<size_t> moved;
+                        for (const auto s : dfa_states[i])
+                        {
+                            if (nfa_states[s].next != detail::npos && nfa_states[s].set.contains(representatives[k]))
+                                moved.push_back(nfa_states[s].next);
+                        }
+                        table.push_back(add_dfa_state(closure(nfa, moved)));
+                    }
+                }
+
+                minimize(table, accept, start);
+            }
+
+            // Matches the longest token at the front of the input
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, Lexeme<In>>
+            {
+                uint32_t state = start_;
+                size_t kind = detail::npos;
+                size_t matched = 0;
+
+                for (size_t i = 0; i < length(in); ++i)
+                {
+                    state = table_[state * class_count_ + class_of_[static_cast<unsigned char>(in[i])]];
+
+                    if (state == dead_)
+                        break;
+
+                    if (accept_[state] != detail::npos)
+                    {
+                        kind = accept_[state];
+                        matched = i + 1;
+                    }
+                }
+
+                if (kind == detail::npos)
+                    return nothing;
+                else
+                    return tuple(drop(matched, in), Lexeme<In>{kind, take(matched, in)});
+            }
+
+            // Appends the tokens of the input to out in a single pass.
+            // Returns the rest of the input from where no token matches, which is empty on success.
+            template <typename In, typename Out>
+            In tokenize(const In &in, Out &out) const
+            {
+                In rest = in;
+                while (length(rest) > 0)
+                {
+                    const auto res = parse(rest);
+                    if (!res)
+                        break;
+
+                    out.push_back(snd(res.value()));
+                    rest = fst(res.value());
+                }
+                return rest;
+            }
+
+            // Number of states of the minimized DFA, including the dead state
+            size_t state_count() const
+            {
+                return accept_.size();
+            }
+
+            size_t class_count() const
+            {
+                return class_count_;
+            }
+
+        private:
+            static std::vector<size_t> closure(const detail::Nfa &nfa, std::vector<size_t> set)
+            {
+                const auto &nfa_states = nfa.states();
+                std::vector<bool> visited(nfa_states.size(), false);
+                for (const auto s : set)
+                    visited[s] = true;
+
+                for (size_t i = 0; i < set.size(); ++i)
+                {
+                    for (const auto t : nfa_states[set[i]].eps)
+                    {
+                        if (!visited[t])
+                        {
+                            visited[t] = true;
+                            set.push_back(t);
+                        }
+                    }
+                }
+
+                std::sort(set.begin(), set.end());
+                return set;
+            }
+
+            // Moore's partition refinement
+            void minimize(const std::vector<size_t> &table, const std::vector<size_t> &accept, size_t start)
+            {
+                const size_t n = accept.size();
+                std::vector<size_t> part(n);
+                size_t part_count = 0;
+
+                {
+                    std::map<size_t, size_t> ids;
+                    for (size_t s = 0; s < n; ++s)
+                    {
+                        const auto it = ids.insert(std::make_pair(accept[s], ids.size())).first;
+                        part[s] = it->second;
+                    }
+                    part_count = ids.size();
+                }
+
+                while (true)
+                {
+                    std::map<std::vector<size_t>, size_t> ids;
+                    std::vector<size_t> next_part(n);
+                    for (size_t s = 0; s < n; ++s)
+                    {
+                        std::vector<size_t> signature(1, part[s]);
+                        for (size_t k = 0; k < class_count_; ++k)
+                            signature.push_back(part[table[s * class_count_ + k]]);
+
+                        const auto it = ids.insert(std::make_pair(signature, ids.size())).first;
+                        next_part[s] = it->second;
+                    }
+
+                    part.swap(next_part);
+                    if (ids.size() == part_count)
+                        break;
+                    part_count = ids.size();
+                }
+
+                table_.assign(part_count * class_count_, 0);
+                accept_.assign(part_count, detail::npos);
+                for (size_t s = 0; s < n; ++s)
+                {
+                    accept_[part[s]] = accept[s];
+                    for (size_t k = 0; k < class_count_; ++k)
+                        table_[part[s] * class_count_ + k] = static_cast<uint32_t>(part[table[s * class_count_ + k]]);
+                }
+
+                dead_ = static_cast<uint32_t>(part[0]);
+                start_ = static_cast<uint32_t>(part[start]);
+            }
+
+            uint8_t class_of_[256];
+            size_t class_count_;
+            std::vector<uint32_t> table_;
+            std::vector<size_t> accept_;
+            uint32_t start_;
+            uint32_t dead_;
+        };
+
+        template <typename... Ps>
+        Lexer lexer(const Ps &...ps)
+        {
+            detail::Nfa nfa;
+            detail::add_tokens<0>(nfa, tuple(ps...));
+            return Lexer(nfa);
+        }
+
+        // lexeme: Matches a Lexeme of the given kind
+        struct LexemeParser : ParserBase<LexemeParser>
+        {
+            size_t kind;
+
+            constexpr explicit LexemeParser(size_t kind)
+                : kind(kind) {}
+
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, ElementOf<In>>
+            {
+                if (length(in) > 0 && matches(in))
+                    return tuple(drop(1, in), in[0]);
+                else
+                    return nothing;
+            }
+
+            size_t width() const
+            {
+                return 1;
+            }
+
+            template <typename In>
+            bool matches(const In &in) const
+            {
+                return in[0].kind == kind;
+            }
+
+            template <typename In>
+            ElementOf<In> output(const In &in) const
+            {
+                return in[0];
+            }
+        };
+
+        template <>
+        struct IsFixedWidth<LexemeParser> : std::true_type
+        {
+        };
+
+        constexpr LexemeParser lexeme(size_t kind)
+        {
+            return LexemeParser(kind);
+        }
+    }
+}
+
+#endif
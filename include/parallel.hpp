@@ -0,0 +1,357 @@
+#ifndef EFP_PARALLEL_HPP_
+#define EFP_PARALLEL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "parser_base.hpp"
+
+// parallel_separated: Matches zero or more p separated by sep, and returns their outputs in order.
+// The elements are first located by skim in skim mode, a cheap parser matching the same extent as p, such as a scan
+// to the next separator, or p itself. Then p parses each of them on worker threads, which take elements from the
+// front of their own range and steal the back half of the range of another once theirs runs out.
+// The list ends right before the first element which p does not match as a whole.
+// Inputs shorter than min_length, or with a single thread, are located and parsed element by element on the calling
+// thread, so they match the same list.
+// The parsers are shared by the workers, which every parser of this library allows once constructed.
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+            // WorkRange
+            // Indices [begin, end) of the elements left to a worker, packed into a single word.
+            // The owner taking from the front and a thief taking from the back are each a single compare-exchange.
+            // Each range is on its own cache line, so the workers do not contend on the ranges of their neighbors.
+
+            struct alignas(64) WorkRange
+            {
+                std::atomic<uint64_t> packed;
+
+                WorkRange()
+                    : packed(0) {}
+
+                static uint64_t pack(uint32_t begin, uint32_t end)
+                {
+                    return (static_cast<uint64_t>(begin) << 32) | end;
+                }
+
+                // Takes up to grain elements from the front, false if there is none left
+                bool take_front(uint32_t grain, uint32_t &begin, uint32_t &end)
+                {
+                    uint64_t r = packed.load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        const uint32_t b = static_cast<uint32_t>(r >> 32);
+                        const uint32_t e = static_cast<uint32_t>(r);
+                        if (b >= e)
+                            return false;
+
+                        const uint32_t taken = std::min(e - b, grain);
+                        if (packed.compare_exchange_weak(r, pack(b + taken, e), std::memory_order_acq_rel))
+                        {
+                            begin = b;
+                            end = b + taken;
+                            return true;
+                        }
+                    }
+                }
+
+                // Takes the back half, rounded up, false if there is none left
+                bool steal_back(uint32_t &begin, uint32_t &end)
+                {
+                    uint64_t r = packed.load(std::memory_order_acquire);
+                    while (true)
+                    {
+                        const uint32_t b = static_cast<uint32_t>(r >> 32);
+                        const uint32_t e = static_cast<uint32_t>(r);
+                        if (b >= e)
+                            return false;
+
+                        const uint32_t mid = b + (e - b) / 2;
+                        if (packed.compare_exchange_weak(r, pack(b, mid), std::memory_order_acq_rel))
+                        {
+                            begin = mid;
+                            end = e;
+                            return true;
+                        }
+                    }
+                }
+            };
+
+            // Outputs written by index from several threads.
+            // std::vector<bool> packs its elements into shared words, so bool outputs are held as bytes instead.
+            template <typename Out>
+            struct OutputBuffer
+            {
+                using Type = std::vector<Out>;
+
+                static std::vector<Out> take(Type &buffer, size_t count)
+                {
+                    buffer.resize(count);
+                    return std::move(buffer);
+                }
+            };
+
+            template <>
+            struct OutputBuffer<bool>
+            {
+                using Type = std::vector<uint8_t>;
+
+                static std::vector<bool> take(const Type &buffer, size_t count)
+                {
+                    return std::vector<bool>(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+                }
+            };
+
+            // Lowers the index of the first failed element to i, if it is lower
+            inline void lower_to(std::atomic<size_t> &first_failed, size_t i)
+            {
+                size_t current = first_failed.load(std::memory_order_relaxed);
+                while (i < current && !first_failed.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                {
+                }
+            }
+        }
+
+        // ParallelSeparatedParser
+        // Matches zero or more p separated by sep like separated0, and returns their outputs.
+        // The output of p must be default constructible, as the outputs are written in place by index.
+        // An exception thrown by p on a worker fails its element, and is rethrown on the calling thread once the workers
+        // all returned if no element before it failed, as it would be thrown on a single thread.
+
+        template <typename Sep, typename Skim, typename P>
+        struct ParallelSeparatedParser : ParserBase<ParallelSeparatedParser<Sep, Skim, P>>
+        {
+            Sep sep;
+            Skim skim;
+            P p;
+            size_t threads;
+            size_t min_length;
+
+            ParallelSeparatedParser(const Sep &sep, const Skim &skim, const P &p, size_t threads, size_t min_length)
+                : sep(sep), skim(skim), p(p), threads(threads), min_length(min_length) {}
+
+            template <typename In>
+            auto parse(const In &in) const
+                -> Parsed<In, std::vector<CallParserO<P, In>>>
+            {
+                using Out = CallParserO<P, In>;
+
+                if (length(in) < min_length || thread_count() <= 1)
+                    return parse_serial(in);
+
+                // Offsets of the elements
+                std::vector<size_t> begins;
+                std::vector<size_t> ends;
+                locate(in, begins, ends);
+
+                const size_t n = begins.size();
+                typename detail::OutputBuffer<Out>::Type outputs(n);
+                std::atomic<size_t> first_failed(n);
+
+                // The ranges hold 32 bit indices
+                const size_t workers = n > UINT32_MAX ? 1 : std::min(thread_count(), n);
+                if (workers <= 1)
+                {
+                    size_t at = 0;
+                    parse_elements(in, begins, ends, 0, n, outputs, first_failed, at);
+                }
+                else
+                {
+                    std::vector<detail::WorkRange> ranges(workers);
+                    for (size_t w = 0; w < workers; ++w)
+                    {
+                        ranges[w].packed.store(detail::WorkRange::pack(static_cast<uint32_t>(n * w / workers),
+                                                                       static_cast<uint32_t>(n * (w + 1) / workers)),
+                                               std::memory_order_relaxed);
+                    }
+
+                    // Small enough steps to balance the load, large enough to keep the ranges mostly uncontended
+                    const uint32_t grain = static_cast<uint32_t>(std::max<size_t>(1, n / (workers * 64)));
+
+                    // An exception would end the process if it left a thread, so it fails its element instead.
+                    // It is rethrown only if that element is the first failed, as a single thread would not reach it
+                    // past an earlier one.
+                    std::vector<std::exception_ptr> errors(workers);
+                    std::vector<size_t> error_at(workers);
+                    const auto work = [&](size_t w)
+                    {
+                        size_t at = 0;
+                        try
+                        {
+                            run_worker(in, begins, ends, ranges, w, grain, outputs, first_failed, at);
+                        }
+                        catch (...)
+                        {
+                            errors[w] = std::current_exception();
+                            error_at[w] = at;
+                            detail::lower_to(first_failed, at);
+                        }
+                    };
+
+                    std::vector<std::thread> pool;
+                    pool.reserve(workers - 1);
+                    for (size_t w = 1; w < workers; ++w)
+                        pool.emplace_back(work, w);
+
+                    work(0);
+
+                    for (auto &t : pool)
+                        t.join();
+
+                    const size_t failed = first_failed.load(std::memory_order_relaxed);
+                    for (size_t w = 0; w < workers; ++w)
+                    {
+                        if (errors[w] && error_at[w] == failed)
+                            std::rethrow_exception(errors[w]);
+                    }
+                }
+
+                const size_t count = first_failed.load(std::memory_order_relaxed);
+                if (count == 0)
+                    return tuple(in, std::vector<Out>());
+
+                return tuple(drop(ends[count - 1], in), detail::OutputBuffer<Out>::take(outputs, count));
+            }
+
+        private:
+            // Skims the elements and separators, recording where each element begins and ends
+            template <typename In>
+            void locate(const In &in, std::vector<size_t> &begins, std::vector<size_t> &ends) const
+            {
+                const size_t total = length(in);
+
+                const auto first = detail::parse_skim(skim, in, 0);
+                if (!first)
+                    return;
+
+                begins.push_back(0);
+                ends.push_back(total - length(first.value()));
+                In rest = first.value();
+
+                while (true)
+                {
+                    const auto res_sep = detail::parse_skim(sep, rest, 0);
+                    if (!res_sep)
+                        break;
+
+                    // A separator and element consuming nothing end the list, as in separated0
+                    const auto res = detail::parse_skim(skim, res_sep.value(), 0);
+                    if (!res || length(res.value()) == length(rest))
+                        break;
+
+                    begins.push_back(total - length(res_sep.value()));
+                    ends.push_back(total - length(res.value()));
+                    rest = res.value();
+                }
+            }
+
+            size_t thread_count() const
+            {
+                const size_t hardware = std::thread::hardware_concurrency();
+                return threads > 0 ? threads : (hardware > 0 ? hardware : 1);
+            }
+
+            // Locates and parses the elements one after the other, by the same rule as the workers
+            template <typename In>
+            auto parse_serial(const In &in) const
+                -> Parsed<In, std::vector<CallParserO<P, In>>>
+            {
+                std::vector<CallParserO<P, In>> outputs;
+                In rest = in;
+                In element = in;
+
+                while (true)
+                {
+                    const auto located = detail::parse_skim(skim, element, 0);
+                    if (!located || (!outputs.empty() && length(located.value()) == length(rest)))
+                        break;
+
+                    const auto res = p(take(length(element) - length(located.value()), element));
+                    if (!res || length(fst(res.value())) > 0)
+                        break;
+
+                    outputs.push_back(snd(res.value()));
+                    rest = located.value();
+
+                    const auto res_sep = detail::parse_skim(sep, rest, 0);
+                    if (!res_sep)
+                        break;
+
+                    element = res_sep.value();
+                }
+
+                return tuple(rest, std::move(outputs));
+            }
+
+            template <typename In, typename Buffer>
+            void parse_elements(const In &in, const std::vector<size_t> &begins, const std::vector<size_t> &ends,
+                                size_t begin, size_t end, Buffer &outputs,
+                                std::atomic<size_t> &first_failed, size_t &at) const
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    // Elements after a failed one are not part of the list
+                    if (i > first_failed.load(std::memory_order_relaxed))
+                        return;
+
+                    // The element being parsed, should p throw
+                    at = i;
+
+                    const auto res = p(take(ends[i] - begins[i], drop(begins[i], in)));
+                    if (res && length(fst(res.value())) == 0)
+                        outputs[i] = snd(res.value());
+                    else
+                        detail::lower_to(first_failed, i);
+                }
+            }
+
+            template <typename In, typename Buffer>
+            void run_worker(const In &in, const std::vector<size_t> &begins, const std::vector<size_t> &ends,
+                            std::vector<detail::WorkRange> &ranges, size_t self, uint32_t grain,
+                            Buffer &outputs, std::atomic<size_t> &first_failed, size_t &at) const
+            {
+                const size_t workers = ranges.size();
+                uint32_t begin = 0;
+                uint32_t end = 0;
+
+                while (true)
+                {
+                    while (ranges[self].take_front(grain, begin, end))
+                        parse_elements(in, begins, ends, begin, end, outputs, first_failed, at);
+
+                    // Own range is empty, so no one else writes it until the stolen range is stored
+                    bool stolen = false;
+                    for (size_t k = 1; k < workers && !stolen; ++k)
+                        stolen = ranges[(self + k) % workers].steal_back(begin, end);
+
+                    if (!stolen)
+                        return;
+
+                    ranges[self].packed.store(detail::WorkRange::pack(begin, end), std::memory_order_release);
+                }
+            }
+        };
+
+        // threads of 0 is the number of hardware threads
+        template <typename Sep, typename Skim, typename P>
+        auto parallel_separated(const Sep &sep, const Skim &skim, const P &p, size_t threads = 0,
+                                size_t min_length = 1 << 16)
+            -> ParallelSeparatedParser<FuncToFuncPtr<Sep>, FuncToFuncPtr<Skim>, FuncToFuncPtr<P>>
+        {
+            return ParallelSeparatedParser<FuncToFuncPtr<Sep>, FuncToFuncPtr<Skim>, FuncToFuncPtr<P>>(
+                sep, skim, p, threads, min_length);
+        }
+    }
+}
+
+#endif
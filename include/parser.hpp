@@ -5,6 +5,14 @@
 #include "string.hpp"
 #include "character_parser.hpp"
 #include "bytes_parser.hpp"
+#include "token_parser.hpp"
+#include "lexer.hpp"
+#include "batch.hpp"
+#include "parallel.hpp"
+#include "stream.hpp"
+#include "fixed_format_parser.hpp"
+#include "unicode_parser.hpp"
+#include "escaped_string_parser.hpp"
 #include "parser_combinator.hpp"
 
 namespace efp
@@ -1,8 +1,19 @@
 #ifndef EFP_PARSER_BASE_HPP_
 #define EFP_PARSER_BASE_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "prelude.hpp"
 #include "string.hpp"
+#include "config.hpp"
+#include "cursor.hpp"
+#include "rope.hpp"
 
 namespace efp
 {
@@ -18,9 +29,796 @@ namespace efp
         template <typename P>
         using ParserO = TupleAt<1, EnumAt<1, Return<P>>>;
 
-        // ? CRTP interface?
+        // Output of parser P on input In, for the parsers generic over the input
+        template <typename P, typename In>
+        using CallParserO = TupleAt<1, EnumAt<1, CallReturn<P, In>>>;
+
+        // Element type of the input
+        template <typename In>
+        using ElementOf = typename std::decay<decltype(std::declval<const In &>()[0])>::type;
+
+        // String literals are parsed as StringView
+        constexpr StringView as_input(const char *in)
+        {
+            return StringView(in);
+        }
+
+        template <typename In>
+        constexpr const In &as_input(const In &in)
+        {
+            return in;
+        }
+
+        // Rope input
+        // A parser whose output on StringView is also its output on Rope, or a view which becomes one, runs on the
+        // head segment first. Its result stands if it left some of the head, as it then did not need the next
+        // segments. Otherwise it runs again on the Rope itself, which walks the segments as needed.
+        // Parsers which need contiguous data(), such as the SIMD ones, are not usable on Rope.
+
+        // Parsers which could give up a partial match and succeed with a shorter one, such as alt, and the combinators
+        // of them. On the head, the partial match may have been cut short by its end, so they run on the Rope itself.
+        template <typename P>
+        struct Backtracks : std::false_type
+        {
+        };
+
+        namespace detail
+        {
+            // Output on Rope for the output on StringView. Views become Rope, also within sequences.
+            template <typename A>
+            struct RopeOutput
+            {
+                using Type = A;
+
+                static const A &convert(const A &a)
+                {
+                    return a;
+                }
+            };
+
+            template <>
+            struct RopeOutput<StringView>
+            {
+                using Type = Rope;
+
+                static Rope convert(const StringView &a)
+                {
+                    return Rope(a);
+                }
+            };
+
+            template <typename... As>
+            struct RopeOutput<Tuple<As...>>
+            {
+                using Type = Tuple<typename RopeOutput<As>::Type...>;
+
+                static Type convert(const Tuple<As...> &a)
+                {
+                    return convert(a, std::index_sequence_for<As...>{});
+                }
+
+                template <size_t... is>
+                static Type convert(const Tuple<As...> &a, std::index_sequence<is...>)
+                {
+                    return tuple(RopeOutput<As>::convert(get<is>(a))...);
+                }
+            };
+
+            // False as well for the parsers which could not parse StringView, e.g. of a function taking Rope
+            template <typename P, typename = void>
+            struct HeadFirst : std::false_type
+            {
+            };
+
+            template <typename P>
+            struct HeadFirst<P, typename std::conditional<true, void, CallParserO<P, StringView>>::type>
+                : std::integral_constant<bool,
+                                         std::is_same<typename RopeOutput<CallParserO<P, StringView>>::Type,
+                                                      CallParserO<P, Rope>>::value &&
+                                             !Backtracks<P>::value>
+            {
+            };
+
+            template <typename P>
+            auto parse_rope(const P &p, const Rope &in, std::true_type) -> Parsed<Rope, CallParserO<P, Rope>>
+            {
+                using Output = RopeOutput<CallParserO<P, StringView>>;
+
+                const StringView &head = in.head();
+                const auto res = p.parse(head);
+
+                if (!res && in.contiguous())
+                    return nothing;
+
+                if (res && (length(fst(res.value())) > 0 || in.contiguous()))
+                    return tuple(drop(length(head) - length(fst(res.value())), in), Output::convert(snd(res.value())));
+                else
+                    return p.parse(in);
+            }
+
+            template <typename P>
+            auto parse_rope(const P &p, const Rope &in, std::false_type) -> Parsed<Rope, CallParserO<P, Rope>>
+            {
+                return p.parse(in);
+            }
+        }
+
+        // ParserBase
+        // CRTP base of the parsers generic over the input. Derived implements parse(in) for each input type.
+        // parse is const and keeps no state between calls. Whatever a parser derives from its arguments, such as the
+        // character set of one_of, is built on construction. So a grammar could be shared by threads as it is.
+
+        template <typename Derived>
+        struct ParserBase
+        {
+            // D defers the lookup of parse until Derived is complete
+            template <typename In, typename D = Derived>
+            constexpr auto operator()(const In &in) const
+                -> decltype(std::declval<const D &>().parse(as_input(in)))
+            {
+                return static_cast<const D &>(*this).parse(as_input(in));
+            }
+
+            template <typename D = Derived>
+            auto operator()(const Rope &in) const
+                -> decltype(std::declval<const D &>().parse(in))
+            {
+                return detail::parse_rope(static_cast<const D &>(*this), in, detail::HeadFirst<D>{});
+            }
+        };
+
+        // Skipped
+        // Output of a parser whose match is discarded
+
+        struct Skipped
+        {
+        };
+
+        // Event mode
+        // Instead of building its output, a parser could report it to a sink as it goes.
+        // A sink provides value(a) for the outputs, and start(tag) and end(tag) around the matches of event<Tag>(p).
+        // Combinators pass the sink down to their children, so no intermediate Tuple is ever built.
+        // Parsers without their own parse_events(in, sink) report their whole output as a single value.
+        // The sink type is a template parameter, so every event is a direct call.
+
+        namespace detail
+        {
+            template <typename Sink, typename A>
+            void report(Sink &sink, const A &a)
+            {
+                sink.value(a);
+            }
+
+            template <typename Sink>
+            void report(Sink &, const Skipped &)
+            {
+            }
+
+            template <typename P, typename In, typename Sink>
+            auto parse_events(const P &p, const In &in, Sink &sink, int)
+                -> decltype(p.parse_events(in, sink))
+            {
+                return p.parse_events(in, sink);
+            }
+
+            template <typename P, typename In, typename Sink>
+            auto parse_events(const P &p, const In &in, Sink &sink, long)
+                -> Maybe<In>
+            {
+                const auto res = p(in);
+                if (!res)
+                    return nothing;
+
+                report(sink, snd(res.value()));
+                return fst(res.value());
+            }
+
+            // Sink which ignores every event, for the parts whose output is discarded
+            struct NullSink
+            {
+                template <typename A>
+                void value(const A &) {}
+
+                template <typename Tag>
+                void start(const Tag &) {}
+
+                template <typename Tag>
+                void end(const Tag &) {}
+            };
+
+            // EventBuffer
+            // Sink in front of Sink, which holds the events of a parser until it is known whether it matched.
+            // Events pass straight through unless a hold is open, so a parse which needs no hold reports as it goes.
+            // The events held are dropped if the parser fails, and otherwise reported once the last hold is released.
+            // Nested holds share the buffer, so each event is stored once however deep the holds.
+            // A start could be deferred until an event after it is reported. The first few deferred starts are kept
+            // in place, and the queue of the others and of the held events is only allocated once it is needed.
+            // Positions count the events from the construction of the buffer.
+
+            template <typename Sink>
+            class EventBuffer
+            {
+            public:
+                explicit EventBuffer(Sink &sink)
+                    : sink_(&sink), reported_(0), holds_(0), deferred_(0) {}
+
+                EventBuffer(const EventBuffer &) = delete;
+                EventBuffer &operator=(const EventBuffer &) = delete;
+
+                template <typename A>
+                void value(const A &a)
+                {
+                    push(ValueEvent<A>{a});
+                }
+
+                template <typename Tag>
+                void start(const Tag &tag)
+                {
+                    push(StartEvent<Tag>{tag});
+                }
+
+                template <typename Tag>
+                void end(const Tag &tag)
+                {
+                    push(EndEvent<Tag>{tag});
+                }
+
+                // Queues start(Tag{}), reported only along with an event after it
+                template <typename Tag>
+                void defer_start()
+                {
+                    if (queued() == 0 && deferred_ < max_deferred)
+                        deferred_starts_[deferred_++] = &report_start<Tag>;
+                    else
+                        queue().emplace_back(StartEvent<Tag>{Tag{}});
+                }
+
+                size_t position() const
+                {
+                    return reported_ + deferred_ + queued();
+                }
+
+                // Whether the event at position has reached the sink, and could no longer be dropped
+                bool reported(size_t position) const
+                {
+                    return position < reported_;
+                }
+
+                // Drops the events from position on, none of which has been reported
+                void truncate(size_t position)
+                {
+                    while (this->position() > position)
+                    {
+                        if (queued() > 0)
+                            queue_->pop_back();
+                        else
+                            --deferred_;
+                    }
+                }
+
+                // Holds the events from here on, and returns the position to release
+                size_t hold()
+                {
+                    ++holds_;
+                    return position();
+                }
+
+                // Deferred starts before the hold are reported only if the held parser reported
+                void release(size_t position, bool matched)
+                {
+                    --holds_;
+                    if (!matched)
+                        truncate(position);
+                    else if (holds_ == 0 && this->position() > position)
+                        flush();
+                }
+
+                void flush()
+                {
+                    for (size_t i = 0; i < deferred_; ++i)
+                        deferred_starts_[i](*sink_);
+
+                    if (queue_)
+                    {
+                        for (const auto &e : *queue_)
+                            e.report(*sink_);
+                    }
+
+                    reported_ += deferred_ + queued();
+                    deferred_ = 0;
+                    if (queue_)
+                        queue_->clear();
+                }
+
+            private:
+                static constexpr size_t max_deferred = 8;
+
+                template <typename A>
+                struct ValueEvent
+                {
+                    A a;
+
+                    void report(Sink &sink) const
+                    {
+                        sink.value(a);
+                    }
+                };
+
+                template <typename Tag>
+                struct StartEvent
+                {
+                    Tag tag;
+
+                    void report(Sink &sink) const
+                    {
+                        sink.start(tag);
+                    }
+                };
+
+                template <typename Tag>
+                struct EndEvent
+                {
+                    Tag tag;
+
+                    void report(Sink &sink) const
+                    {
+                        sink.end(tag);
+                    }
+                };
+
+                template <typename Tag>
+                static void report_start(Sink &sink)
+                {
+                    sink.start(Tag{});
+                }
+
+                // Event of any type, in place if it is small. Events are never moved, as a deque keeps its elements
+                // in place as it grows at the back.
+                class Event
+                {
+                public:
+                    template <typename E>
+                    explicit Event(const E &e)
+                        : object_(create(e, FitsInPlace<E>{})), report_(&report_as<E>), destroy_(&destroy_as<E>) {}
+
+                    Event(const Event &) = delete;
+                    Event &operator=(const Event &) = delete;
+
+                    ~Event()
+                    {
+                        destroy_(object_);
+                    }
+
+                    void report(Sink &sink) const
+                    {
+                        report_(object_, sink);
+                    }
+
+                private:
+                    template <typename E>
+                    using FitsInPlace =
+                        std::integral_constant<bool, sizeof(E) <= 32 && alignof(E) <= alignof(std::max_align_t)>;
+
+                    template <typename E>
+                    void *create(const E &e, std::true_type)
+                    {
+                        return new (storage_) E(e);
+                    }
+
+                    template <typename E>
+                    void *create(const E &e, std::false_type)
+                    {
+                        return new E(e);
+                    }
+
+                    template <typename E>
+                    static void report_as(const void *e, Sink &sink)
+                    {
+                        static_cast<const E *>(e)->report(sink);
+                    }
+
+                    template <typename E>
+                    static void destroy_as(void *e)
+                    {
+                        destroy_object<E>(e, FitsInPlace<E>{});
+                    }
+
+                    template <typename E>
+                    static void destroy_object(void *e, std::true_type)
+                    {
+                        static_cast<E *>(e)->~E();
+                    }
+
+                    template <typename E>
+                    static void destroy_object(void *e, std::false_type)
+                    {
+                        delete static_cast<E *>(e);
+                    }
+
+                    alignas(std::max_align_t) unsigned char storage_[32];
+                    void *object_;
+                    void (*report_)(const void *, Sink &);
+                    void (*destroy_)(void *);
+                };
+
+                size_t queued() const
+                {
+                    return queue_ ? queue_->size() : 0;
+                }
+
+                std::deque<Event> &queue()
+                {
+                    if (!queue_)
+                        queue_.reset(new std::deque<Event>());
+                    return *queue_;
+                }
+
+                template <typename E>
+                void push(const E &e)
+                {
+                    if (holds_ > 0)
+                    {
+                        queue().emplace_back(e);
+                        return;
+                    }
+
+                    flush();
+                    e.report(*sink_);
+                    ++reported_;
+                }
+
+                Sink *sink_;
+                size_t reported_;
+                size_t holds_;
+                size_t deferred_;
+                void (*deferred_starts_[max_deferred])(Sink &);
+                std::unique_ptr<std::deque<Event>> queue_;
+            };
+        }
+
+        // Parsers which report no event unless they match, so that their failure leaves the sink as it was.
+        // Those without their own parse_events report once they matched. Combinators which try a parser and go on
+        // should it fail, such as alt, hold the events of the others in an EventBuffer until they matched, so a
+        // successful parse reports exactly the events of its match, in a single pass.
+        template <typename P>
+        struct ReportsOnMatch : std::true_type
+        {
+        };
+
+        // parse_events: Runs p in event mode, and returns the remaining input on success.
+        // The parsers report to an EventBuffer in front of sink, so that the holds within share it.
+        template <typename P, typename In, typename Sink>
+        auto parse_events(const P &p, const In &in, Sink &sink)
+            -> Maybe<typename std::decay<decltype(as_input(in))>::type>
+        {
+            detail::EventBuffer<Sink> buffer(sink);
+            const auto res = detail::parse_events(p, as_input(in), buffer, 0);
+            buffer.flush();
+
+            return res;
+        }
+
+        // Parsers which always match a known number of elements.
+        // They provide width(), matches(in) and output(in), of which the latter two assume length(in) >= width().
+        // TupleParser fuses the adjacent ones into a single bounds check and a single combined comparison.
+        template <typename P>
+        struct IsFixedWidth : std::false_type
+        {
+        };
+
+        // Parsers whose every match starts with a byte known at compile time, and which fail on empty input.
+        // AltParser only tries them on inputs starting with that byte.
+        template <typename P>
+        struct FirstByte
+        {
+            static constexpr bool known = false;
+            static constexpr char value = 0;
+        };
+
+        // Skim mode
+        // To only know whether a parser matches and where its match ends, it could run without building its output.
+        // Combinators skim their parsers in turn, so no Tuple is built and no function of map is called.
+        // Parsers whose output costs more than their match, such as the numbers, only validate the match.
+        // Fixed width parsers are only compared. Other parsers without their own parse_skim(in) run as usual, and
+        // their output is discarded.
+
+        namespace detail
+        {
+            template <typename P, typename In>
+            auto parse_skim(const P &p, const In &in, int)
+                -> decltype(p.parse_skim(in))
+            {
+                return p.parse_skim(in);
+            }
+
+            template <typename P, typename In>
+            auto skim_parsed(const P &p, const In &in, std::true_type)
+                -> Maybe<In>
+            {
+                if (length(in) < p.width() || !p.matches(in))
+                    return nothing;
+
+                return drop(p.width(), in);
+            }
+
+            template <typename P, typename In>
+            auto skim_parsed(const P &p, const In &in, std::false_type)
+                -> Maybe<In>
+            {
+                const auto res = p(in);
+                if (!res)
+                    return nothing;
+
+                return fst(res.value());
+            }
+
+            template <typename P, typename In>
+            auto parse_skim(const P &p, const In &in, long)
+                -> Maybe<In>
+            {
+                return skim_parsed(p, in, IsFixedWidth<P>{});
+            }
+        }
+
+        // skim: Runs p in skim mode, and returns the remaining input on success
+        template <typename P, typename In>
+        auto skim(const P &p, const In &in)
+            -> Maybe<typename std::decay<decltype(as_input(in))>::type>
+        {
+            return detail::parse_skim(p, as_input(in), 0);
+        }
+
+        // Step mode
+        // On contiguous characters, a parser could return where its match ends instead of the remaining input.
+        // Step<O> is that end, null if the parser failed, and the output. Unlike Parsed on StringView, it is trivially
+        // copyable for the outputs which are, and of 16 bytes for those of up to 8, so it is returned in registers.
+        // The runs of characters are Step<Matched>, of the end alone, and their view is only made by the caller.
+        // A view with no data steps from an empty array instead, so that no match ends at null.
+        // TupleParser threads a single position through its parsers which provide parse_step(begin, end).
+        // Fixed width parsers are compared in place. Others run as usual on the rest, and their result is converted,
+        // for which their output must be default constructible.
+
+        // Matched
+        // Output of a step which is the view of its match
+
+        struct Matched
+        {
+        };
+
+        template <typename O>
+        struct Step
+        {
+            const char *end;
+            O output;
+
+            constexpr explicit operator bool() const
+            {
+                return end != nullptr;
+            }
+        };
+
+        template <>
+        struct Step<Matched>
+        {
+            const char *end;
+
+            constexpr explicit operator bool() const
+            {
+                return end != nullptr;
+            }
+        };
+
+        namespace detail
+        {
+            template <typename P>
+            constexpr auto parse_step(const P &p, const char *begin, const char *end, int)
+                -> decltype(p.parse_step(begin, end))
+            {
+                return p.parse_step(begin, end);
+            }
+
+            template <typename P>
+            constexpr auto step_parsed(const P &p, const char *begin, const char *end, std::true_type)
+                -> Step<CallParserO<P, StringView>>
+            {
+                const StringView in(begin, static_cast<size_t>(end - begin));
+                if (length(in) < p.width() || !p.matches(in))
+                    return Step<CallParserO<P, StringView>>{nullptr, {}};
+
+                return Step<CallParserO<P, StringView>>{begin + p.width(), p.output(in)};
+            }
+
+            template <typename P>
+            constexpr auto step_parsed(const P &p, const char *begin, const char *end, std::false_type)
+                -> Step<CallParserO<P, StringView>>
+            {
+                const auto res = p(StringView(begin, static_cast<size_t>(end - begin)));
+                if (!res)
+                    return Step<CallParserO<P, StringView>>{nullptr, {}};
+
+                return Step<CallParserO<P, StringView>>{end - length(fst(res.value())), snd(res.value())};
+            }
+
+            template <typename P>
+            constexpr auto parse_step(const P &p, const char *begin, const char *end, long)
+                -> Step<CallParserO<P, StringView>>
+            {
+                return step_parsed(p, begin, end, IsFixedWidth<P>{});
+            }
+
+            // Parsers with their own parse_step
+            template <typename P, typename = void>
+            struct HasStep : std::false_type
+            {
+            };
+
+            template <typename P>
+            struct HasStep<P, typename std::conditional<
+                                  true, void, decltype(std::declval<const P &>().parse_step(std::declval<const char *>(),
+                                                                                            std::declval<const char *>()))>::type>
+                : std::true_type
+            {
+            };
+
+            // Output of a step which started at begin
+            template <typename O>
+            constexpr const O &step_output(const Step<O> &s, const char *)
+            {
+                return s.output;
+            }
+
+            constexpr StringView step_output(const Step<Matched> &s, const char *begin)
+            {
+                return StringView(begin, static_cast<size_t>(s.end - begin));
+            }
+
+            template <typename = void>
+            constexpr char no_data[1] = {};
+
+            // Position of the first character of in, which is not null even if in has no data
+            constexpr const char *step_begin(const StringView &in)
+            {
+                return in.data() != nullptr ? in.data() : no_data<>;
+            }
+        }
+
+        // step: Runs p in step mode on the characters of in
+        template <typename P>
+        constexpr auto step(const P &p, const StringView &in)
+            -> decltype(detail::parse_step(p, in.data(), in.data(), 0))
+        {
+            return detail::parse_step(p, detail::step_begin(in), detail::step_begin(in) + length(in), 0);
+        }
+
+        // to_parsed: Result of a step of p from in, as p returns on in
+        template <typename O>
+        constexpr auto to_parsed(const Step<O> &s, const StringView &in) -> Parsed<StringView, O>
+        {
+            if (!s)
+                return nothing;
+
+            return tuple(drop(static_cast<size_t>(s.end - detail::step_begin(in)), in), s.output);
+        }
+
+        constexpr auto to_parsed(const Step<Matched> &s, const StringView &in) -> Parsed<StringView, StringView>
+        {
+            if (!s)
+                return nothing;
+
+            const size_t n = static_cast<size_t>(s.end - detail::step_begin(in));
+            return tuple(drop(n, in), take(n, in));
+        }
+
+        // Partial mode
+        // On input which may be only the start of what arrives, such as the bytes read so far from a socket, a parser
+        // could tell a need for more input from a failure. Partial is Incomplete if elements past the end of in could
+        // change the result, and otherwise the result on any input which starts with in.
+        // It may be Incomplete where no more input would help, as for the digits of a number past its range, but it is
+        // never Matched or Failed where more input could change that.
+        // Fixed width parsers are Incomplete on fewer elements than their width. The runs of characters and the numbers
+        // are Incomplete while they reach the end of in, as are escaped strings before their closing quote. TupleParser,
+        // AltParser, preceded, terminated, delimited and separated0 combine the results of their parsers, and MapParser,
+        // ValueParser, SkipParser, map_res, verify and event convert that of theirs. A Rule runs in partial mode only
+        // if it is declared with partial, as the parser it holds could not be checked until it is assigned.
+        // Other parsers without their own parse_partial(in) could not run in partial mode.
+
+        enum class PartialStatus : uint8_t
+        {
+            Matched,
+            Incomplete,
+            Failed,
+        };
+
+        // Partial
+        // Status, and the result unless it is Incomplete
+
+        template <typename I, typename O>
+        struct Partial
+        {
+            PartialStatus status;
+            Parsed<I, O> parsed;
+
+            explicit operator bool() const
+            {
+                return status == PartialStatus::Matched;
+            }
+        };
+
+        namespace detail
+        {
+            template <typename I, typename O>
+            Partial<I, O> partial_incomplete()
+            {
+                return Partial<I, O>{PartialStatus::Incomplete, nothing};
+            }
+
+            // Result which no more input could change
+            template <typename I, typename O>
+            Partial<I, O> partial_decided(const Parsed<I, O> &res)
+            {
+                return Partial<I, O>{res ? PartialStatus::Matched : PartialStatus::Failed, res};
+            }
+
+            template <typename P, typename In>
+            auto parse_partial(const P &p, const In &in, int)
+                -> decltype(p.parse_partial(in))
+            {
+                return p.parse_partial(in);
+            }
+
+            template <typename P, typename In>
+            auto partial_parsed(const P &p, const In &in, std::true_type)
+                -> Partial<In, CallParserO<P, In>>
+            {
+                if (length(in) < p.width())
+                    return partial_incomplete<In, CallParserO<P, In>>();
+
+                return partial_decided(p(in));
+            }
+
+            template <typename P, typename In>
+            auto partial_parsed(const P &, const In &, std::false_type)
+                -> Partial<In, CallParserO<P, In>>
+            {
+                static_assert(IsFixedWidth<P>::value,
+                              "The parser has no parse_partial, so it could not tell a need for more input from a failure");
+                return partial_incomplete<In, CallParserO<P, In>>();
+            }
+
+            template <typename P, typename In>
+            auto parse_partial(const P &p, const In &in, long)
+                -> Partial<In, CallParserO<P, In>>
+            {
+                return partial_parsed(p, in, IsFixedWidth<P>{});
+            }
+        }
+
+        // partial: Runs p in partial mode on what was received so far of its input
+        template <typename P, typename In>
+        auto partial(const P &p, const In &in)
+            -> decltype(detail::parse_partial(p, as_input(in), 0))
+        {
+            return detail::parse_partial(p, as_input(in), 0);
+        }
+
         template <typename In>
-        bool start_with(const In &in, const In &t)
+        constexpr bool start_with(const In &in, const In &t)
+        {
+            const auto t_length = length(t);
+
+            if (length(in) >= t_length)
+            {
+                for (size_t i = 0; i < t_length; ++i)
+                {
+                    if (in[i] != t[i])
+                        return false;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        constexpr bool start_with(const StringView &in, const StringView &t)
         {
             const auto t_length = length(t);
 
@@ -36,7 +834,7 @@ namespace efp
             return false;
         }
 
-        bool start_with(const StringView &in, const StringView &t)
+        inline bool start_with(const Cursor &in, const StringView &t)
         {
             const auto t_length = length(t);
 
@@ -51,6 +849,38 @@ namespace efp
             }
             return false;
         }
+
+        inline bool start_with(const Rope &in, const StringView &t)
+        {
+            const auto t_length = length(t);
+
+            if (length(in.head()) >= t_length)
+                return start_with(in.head(), t);
+
+            if (length(in) >= t_length)
+            {
+                for (size_t i = 0; i < t_length; ++i)
+                {
+                    if (in[i] != t[i])
+                        return false;
+                }
+                return true;
+            }
+            return false;
+        }
+
+        // Elements are compared by ==, except Enum tokens which are compared by their alternative index only
+        template <typename A>
+        constexpr bool element_eq(const A &a, const A &b)
+        {
+            return a == b;
+        }
+
+        template <typename... As>
+        bool element_eq(const Enum<As...> &a, const Enum<As...> &b)
+        {
+            return a.index() == b.index();
+        }
     }
 }
 
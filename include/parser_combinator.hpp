@@ -1,6 +1,12 @@
 #ifndef EFP_PARSER_COMBINATOR_HPP_
 #define EFP_PARSER_COMBINATOR_HPP_
 
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #include "parser_base.hpp"
 
 namespace efp
@@ -9,99 +15,1772 @@ namespace efp
     {
 
         // Parser combinators
+        // The parsers of a combinator are walked by an index sequence, and the output type is computed once per input.
+        // TupleParser expands them into a single array initializer, which runs them in order with no recursion.
+        // AltParser steps through them by a single index, as returning the first match directly is measurably faster
+        // than calls through an array of pointers, which are not inlined.
+
+        namespace detail
+        {
+            template <bool...>
+            struct BoolPack
+            {
+            };
+
+            template <bool... bs>
+            using AllOf = std::is_same<BoolPack<bs..., true>, BoolPack<true, bs...>>;
+
+            template <bool... bs>
+            using AnyOf = std::integral_constant<bool, !std::is_same<BoolPack<bs..., false>, BoolPack<false, bs...>>::value>;
+
+            // Bit i of candidates[b] is set if the i-th parser could match an input starting with b.
+            // The last entry is for the empty input.
+            struct FirstByteTable
+            {
+                uint64_t candidates[257];
+            };
+
+            template <typename... Ps>
+            constexpr FirstByteTable make_first_byte_table()
+            {
+                const bool known[] = {FirstByte<Ps>::known...};
+                const char bytes[] = {FirstByte<Ps>::value...};
+
+                FirstByteTable table{};
+                for (size_t i = 0; i < sizeof...(Ps); ++i)
+                {
+                    for (size_t b = 0; b < 257; ++b)
+                    {
+                        if (!known[i] || b == static_cast<unsigned char>(bytes[i]))
+                            table.candidates[b] |= uint64_t(1) << i;
+                    }
+                }
+                return table;
+            }
+
+            template <typename... Ps>
+            constexpr FirstByteTable first_byte_table = make_first_byte_table<Ps...>();
+
+            template <typename P, typename In, typename Sink>
+            auto parse_events_on_match(const P &p, const In &in, Sink &sink, std::true_type) -> Maybe<In>
+            {
+                return parse_events(p, in, sink, 0);
+            }
+
+            template <typename P, typename In, typename Sink>
+            auto parse_events_on_match(const P &p, const In &in, EventBuffer<Sink> &buffer, std::false_type)
+                -> Maybe<In>
+            {
+                const size_t position = buffer.hold();
+                const auto res = parse_events(p, in, buffer, 0);
+                buffer.release(position, static_cast<bool>(res));
+
+                return res;
+            }
+
+            template <typename P, typename In, typename Sink>
+            auto parse_events_on_match(const P &p, const In &in, Sink &sink, std::false_type) -> Maybe<In>
+            {
+                EventBuffer<Sink> buffer(sink);
+                const auto res = parse_events_on_match(p, in, buffer, std::false_type{});
+                buffer.flush();
+
+                return res;
+            }
+
+            // Nothing to hold back
+            template <typename P, typename In>
+            auto parse_events_on_match(const P &p, const In &in, NullSink &null, std::false_type) -> Maybe<In>
+            {
+                return parse_events(p, in, null, 0);
+            }
+
+            // Runs p in event mode, reporting nothing unless it matches.
+            // The events of parsers which could fail after they reported are held until they matched, in the buffer
+            // of the enclosing hold if there is one, so that nested parsers are still parsed once.
+            template <typename P, typename In, typename Sink>
+            auto parse_events_on_match(const P &p, const In &in, Sink &sink) -> Maybe<In>
+            {
+                return parse_events_on_match(p, in, sink, ReportsOnMatch<P>{});
+            }
+        }
+
+        // AltParser
+        // Tries the parsers in order, and returns the first match.
+        // If some of them start with a known byte, a table lookup on the first byte of the input skips those which
+        // could not match.
+
         template <typename... Ps>
-        struct AltParser
+        struct AltParser : ParserBase<AltParser<Ps...>>
         {
             Tuple<Ps...> ps;
 
-            template <size_t n, typename In, typename = EnableIf<(n < sizeof...(Ps))>>
-            auto impl(const In &in) -> Common<CallReturn<Ps, In>...>
+            constexpr explicit AltParser(const Tuple<Ps...> &ps)
+                : ps(ps) {}
+
+            template <typename In>
+            using Dispatch = std::integral_constant<bool, detail::AnyOf<FirstByte<Ps>::known...>::value &&
+                                                              (sizeof...(Ps) <= 64) &&
+                                                              std::is_same<ElementOf<In>, char>::value>;
+
+            template <typename In>
+            constexpr auto parse(const In &in) const -> Common<CallReturn<Ps, In>...>
             {
-                const auto res = get<n>(ps)(in);
+                return parse_impl<Common<CallReturn<Ps, In>...>, Dispatch<In>::value, 0>(
+                    in, candidates(in, Dispatch<In>{}), IsAlternative<0>{});
+            }
 
-                if (res)
-                    return res;
+            template <typename In>
+            static constexpr uint64_t candidates(const In &in, std::true_type)
+            {
+                const size_t b = length(in) == 0 ? 256 : static_cast<unsigned char>(in[0]);
+                return detail::first_byte_table<Ps...>.candidates[b];
+            }
+
+            template <typename In>
+            static constexpr uint64_t candidates(const In &, std::false_type)
+            {
+                return ~uint64_t(0);
+            }
+
+            template <size_t i>
+            using IsAlternative = std::integral_constant<bool, (i < sizeof...(Ps))>;
+
+            template <typename In>
+            using Output = TupleAt<1, EnumAt<1, Common<CallReturn<Ps, In>...>>>;
+
+            // Each step is instantiated on its index alone, so that a wide alternation instantiates linearly
+            template <typename Out, bool dispatch, size_t i, typename In>
+            constexpr auto parse_impl(const In &in, uint64_t candidates, std::true_type) const -> Out
+            {
+                if (!dispatch || (candidates >> i & 1))
+                {
+                    const auto res = get<i>(ps)(in);
+
+                    if (res)
+                        return res;
+                }
+
+                return parse_impl<Out, dispatch, i + 1>(in, candidates, IsAlternative<i + 1>{});
+            }
+
+            template <typename Out, bool dispatch, size_t i, typename In>
+            constexpr auto parse_impl(const In &, uint64_t, std::false_type) const -> Out
+            {
+                return nothing;
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return skim_impl<Dispatch<In>::value, 0>(in, candidates(in, Dispatch<In>{}), IsAlternative<0>{});
+            }
+
+            template <bool dispatch, size_t i, typename In>
+            auto skim_impl(const In &in, uint64_t candidates, std::true_type) const -> Maybe<In>
+            {
+                if (!dispatch || (candidates >> i & 1))
+                {
+                    const auto res = detail::parse_skim(get<i>(ps), in, 0);
+
+                    if (res)
+                        return res;
+                }
+
+                return skim_impl<dispatch, i + 1>(in, candidates, IsAlternative<i + 1>{});
+            }
+
+            template <bool dispatch, size_t i, typename In>
+            auto skim_impl(const In &, uint64_t, std::false_type) const -> Maybe<In>
+            {
+                return nothing;
+            }
+
+            // Only the alternative which matches reports
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                return events_impl(in, sink, std::index_sequence_for<Ps...>{});
+            }
+
+            template <typename In, typename Sink, size_t... is>
+            auto events_impl(const In &in, Sink &sink, std::index_sequence<is...>) const -> Maybe<In>
+            {
+                In rest = in;
+                bool matched = false;
+
+                const bool steps[] = {false, (matched = matched || events_alternative<is>(in, sink, rest))...};
+                (void)steps;
+
+                if (matched)
+                    return rest;
                 else
-                    return impl<n + 1>(in);
+                    return nothing;
             }
 
-            // Base case: when n equals the size of the tuple, stop recursion.
-            template <size_t n, typename In, typename = EnableIf<(n >= sizeof...(Ps))>, typename = void>
-            auto impl(const In &in) -> Common<CallReturn<Ps, In>...>
+            template <size_t i, typename In, typename Sink>
+            bool events_alternative(const In &in, Sink &sink, In &rest) const
             {
-                return nothing; // Or some representation of failure
+                const auto res = detail::parse_events_on_match(get<i>(ps), in, sink);
+
+                if (!res)
+                    return false;
+
+                rest = res.value();
+                return true;
+            }
+
+            // An alternative which is incomplete decides whether the later ones are tried, so the choice is as well
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, Output<In>>
+            {
+                return partial_impl<Partial<In, Output<In>>, 0>(in, IsAlternative<0>{});
+            }
+
+            template <typename Out, size_t i, typename In>
+            auto partial_impl(const In &in, std::true_type) const -> Out
+            {
+                const auto res = detail::parse_partial(get<i>(ps), in, 0);
+
+                if (res.status != PartialStatus::Failed)
+                    return Out{res.status, res.parsed};
+
+                return partial_impl<Out, i + 1>(in, IsAlternative<i + 1>{});
             }
 
-            auto operator()(const Common<ParserI<Ps>...> &in) -> Common<CallReturn<Ps, Common<ParserI<Ps>...>>...>
+            template <typename Out, size_t i, typename In>
+            auto partial_impl(const In &, std::false_type) const -> Out
             {
-                return impl<0>(in);
+                return Out{PartialStatus::Failed, nothing};
             }
         };
 
         template <typename... Ps>
-        auto alt(const Ps &...ps)
+        constexpr auto alt(const Ps &...ps)
             -> AltParser<FuncToFuncPtr<Ps>...>
         {
-            return AltParser<FuncToFuncPtr<Ps>...>{tuple(ps...)};
+            return AltParser<FuncToFuncPtr<Ps>...>(tuple(ps...));
         }
 
+        template <typename... Ps>
+        struct Backtracks<AltParser<Ps...>> : std::true_type
+        {
+        };
+
         // TupleParser
-        // Basic sequential parser
+        // Basic sequential parser. On StringView, the parsers which provide parse_step run in step mode.
 
         namespace detail
         {
-            template <size_t n, typename Tuple, typename In, typename... Results>
-            struct TupleParserImpl
+            // Role of the n-th parser in the runs of adjacent fixed width parsers:
+            // 0 if it is not in a run of two or more, 1 if it starts one, 2 if it continues one.
+            template <bool... fixed>
+            constexpr int fixed_run_role(size_t n)
+            {
+                const bool flags[] = {false, fixed..., false};
+
+                // flags is shifted by one, so that n + 1 is the n-th parser
+                if (!flags[n + 1] || (!flags[n] && !flags[n + 2]))
+                    return 0;
+                else
+                    return flags[n] ? 2 : 1;
+            }
+
+            // Number of adjacent fixed width parsers from n
+            template <bool... fixed>
+            constexpr size_t fixed_run_length(size_t n)
+            {
+                const bool flags[] = {fixed..., false};
+
+                size_t count = 0;
+                while (flags[n + count])
+                    ++count;
+                return count;
+            }
+
+            // Outputs which need no cleanup are plain members, so that a TupleParser of them is usable in constant
+            // expressions. Others are constructed in place once their parser has matched.
+            template <typename A>
+            struct IsPlainOutput
+                : std::integral_constant<bool, std::is_trivially_destructible<A>::value &&
+                                                   std::is_default_constructible<A>::value>
             {
             };
 
-            template <size_t n, typename In, typename... Ps, typename... Results>
-            struct TupleParserImpl<n, Tuple<Ps...>, In, Results...>
+            // Storage for the output of the i-th parser
+            template <size_t i, typename A, bool = IsPlainOutput<A>::value>
+            struct TupleSlot
             {
-                static auto process(const Tuple<Ps...> &t, const In &in, Results... results)
-                    -> Parsed<Common<ParserI<Ps>...>, Tuple<ParserO<Ps>...>>
+                A value{};
+
+                template <typename B>
+                constexpr void construct(const B &b)
                 {
-                    const auto res = get<n>(t)(in);
+                    value = b;
+                }
 
-                    if (!res)
-                        return nothing; // If any parser fails, return nothing
-                    else
-                        // Recursive call with the next index
-                        return TupleParserImpl<n + 1, Tuple<Ps...>, In, Results..., decltype(snd(res.value()))>::process(
-                            t, fst(res.value()), results..., snd(res.value()));
+                constexpr A &get()
+                {
+                    return value;
+                }
+
+                constexpr void destroy() {}
+            };
+
+            template <size_t i, typename A>
+            struct TupleSlot<i, A, false>
+            {
+                alignas(A) unsigned char storage[sizeof(A)];
+
+                template <typename B>
+                void construct(const B &b)
+                {
+                    new (storage) A(b);
+                }
+
+                A &get()
+                {
+                    return *reinterpret_cast<A *>(storage);
+                }
+
+                void destroy()
+                {
+                    get().~A();
+                }
+            };
+
+            template <typename Is, typename... Os>
+            struct TupleSlotsBase
+            {
+            };
+
+            // Outputs of the parsers of a TupleParser, each set once its parser has matched
+            template <size_t... is, typename... Os>
+            struct TupleSlotsBase<std::index_sequence<is...>, Os...> : TupleSlot<is, Os>...
+            {
+                size_t count = 0;
+
+                template <size_t i>
+                constexpr auto slot() -> TupleSlot<i, TupleAt<i, Tuple<Os...>>> &
+                {
+                    return *this;
+                }
+
+                template <size_t i, typename O>
+                constexpr void set(const O &o)
+                {
+                    slot<i>().construct(o);
+                    ++count;
+                }
+
+                template <size_t i>
+                constexpr auto output() -> TupleAt<i, Tuple<Os...>> &
+                {
+                    return slot<i>().get();
                 }
             };
 
-            // Specialization for the base case
-            template <typename In, typename... Ps, typename... Results>
-            struct TupleParserImpl<sizeof...(Ps), Tuple<Ps...>, In, Results...>
+            template <typename Is, bool plain, typename... Os>
+            struct TupleSlotsImpl : TupleSlotsBase<Is, Os...>
             {
-                static auto process(const Tuple<Ps...> &t, const In &in, Results... results)
-                    -> Parsed<Common<ParserI<Ps>...>, Tuple<ParserO<Ps>...>>
+            };
+
+            // Destroys the outputs already constructed when a later parser fails
+            template <size_t... is, typename... Os>
+            struct TupleSlotsImpl<std::index_sequence<is...>, false, Os...>
+                : TupleSlotsBase<std::index_sequence<is...>, Os...>
+            {
+                TupleSlotsImpl() = default;
+                TupleSlotsImpl(const TupleSlotsImpl &) = delete;
+                TupleSlotsImpl &operator=(const TupleSlotsImpl &) = delete;
+
+                ~TupleSlotsImpl()
                 {
-                    return tuple(in, tuple(results...)); // Returning the accumulated results
+                    const int destroyed[] = {0, (is < this->count ? (this->template slot<is>().destroy(), 0) : 0)...};
+                    (void)destroyed;
                 }
             };
+
+            template <typename Is, typename... Os>
+            using TupleSlots = TupleSlotsImpl<Is, AllOf<IsPlainOutput<Os>::value...>::value, Os...>;
         }
 
         template <typename... Ps>
-        struct TupleParser
+        struct TupleParser : ParserBase<TupleParser<Ps...>>
         {
             Tuple<Ps...> ps;
 
-            auto operator()(const Common<ParserI<Ps>...> &in) const
-                -> Parsed<Common<ParserI<Ps>...>, Tuple<ParserO<Ps>...>>
+            constexpr explicit TupleParser(const Tuple<Ps...> &ps)
+                : ps(ps) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, Tuple<CallParserO<Ps, In>...>>
+            {
+                return parse_impl<Tuple<CallParserO<Ps, In>...>>(in, std::index_sequence_for<Ps...>{});
+            }
+
+            template <typename Out, typename In, size_t... is>
+            constexpr auto parse_impl(const In &in, std::index_sequence<is...>) const
+                -> Parsed<In, Out>
+            {
+                detail::TupleSlots<std::index_sequence<is...>, CallParserO<Ps, In>...> slots;
+                In rest = in;
+                bool ok = true;
+
+                const bool steps[] = {true, (ok = ok && step<is>(rest, slots, Role<is>{}))...};
+                (void)steps;
+
+                if (!ok)
+                    return nothing;
+                else
+                    return tuple(rest, tuple(slots.template output<is>()...));
+            }
+
+            template <size_t i>
+            using Role = std::integral_constant<int, detail::fixed_run_role<IsFixedWidth<Ps>::value...>(i)>;
+
+            template <size_t i, typename In, typename Slots>
+            constexpr bool step(In &rest, Slots &slots, std::integral_constant<int, 0>) const
+            {
+                using Steps = std::integral_constant<bool, std::is_same<In, StringView>::value &&
+                                                               detail::HasStep<TupleAt<i, Tuple<Ps...>>>::value>;
+
+                return step_one<i>(rest, slots, Steps{});
+            }
+
+            template <size_t i, typename In, typename Slots>
+            constexpr bool step_one(In &rest, Slots &slots, std::false_type) const
+            {
+                const auto res = get<i>(ps)(rest);
+
+                if (!res)
+                    return false; // If any parser fails, return nothing
+
+                slots.template set<i>(snd(res.value()));
+                rest = fst(res.value());
+                return true;
+            }
+
+            // Step mode on StringView, whose result is returned in registers, and whose output is taken from there
+            template <size_t i, typename Slots>
+            constexpr bool step_one(StringView &rest, Slots &slots, std::true_type) const
+            {
+                const char *begin = detail::step_begin(rest);
+                const char *end = begin + length(rest);
+                const auto res = get<i>(ps).parse_step(begin, end);
+
+                if (!res)
+                    return false;
+
+                slots.template set<i>(detail::step_output(res, begin));
+                rest = StringView(res.end, static_cast<size_t>(end - res.end));
+                return true;
+            }
+
+            // Run of fixed width parsers: one bounds check and one combined comparison for all of them
+            template <size_t i, typename In, typename Slots>
+            constexpr bool step(In &rest, Slots &slots, std::integral_constant<int, 1>) const
+            {
+                using Run = std::make_index_sequence<detail::fixed_run_length<IsFixedWidth<Ps>::value...>(i)>;
+
+                if (!run_matches<i>(rest, Run{}))
+                    return false;
+                else
+                    return step<i>(rest, slots, std::integral_constant<int, 2>{});
+            }
+
+            // Fixed width parser of a run which is already known to match
+            template <size_t i, typename In, typename Slots>
+            constexpr bool step(In &rest, Slots &slots, std::integral_constant<int, 2>) const
+            {
+                slots.template set<i>(get<i>(ps).output(rest));
+                rest = drop(get<i>(ps).width(), rest);
+                return true;
+            }
+
+            template <size_t i, typename In, size_t... js>
+            constexpr bool run_matches(const In &in, std::index_sequence<js...>) const
+            {
+                const size_t widths[] = {get<i + js>(ps).width()...};
+
+                size_t offsets[sizeof...(js)] = {};
+                size_t width = 0;
+                for (size_t k = 0; k < sizeof...(js); ++k)
+                {
+                    offsets[k] = width;
+                    width += widths[k];
+                }
+
+                if (length(in) < width)
+                    return false;
+
+                // Non-short-circuit to let the comparisons be merged
+                const bool matches[] = {get<i + js>(ps).matches(drop(offsets[js], in))...};
+
+                bool res = true;
+                for (const bool m : matches)
+                    res &= m;
+                return res;
+            }
+
+            // Each parser reports to the sink in turn, and no Tuple is built
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                return events_impl(in, sink, std::index_sequence_for<Ps...>{});
+            }
+
+            template <typename In, typename Sink, size_t... is>
+            auto events_impl(const In &in, Sink &sink, std::index_sequence<is...>) const -> Maybe<In>
+            {
+                In rest = in;
+                bool ok = true;
+
+                const bool steps[] = {true, (ok = ok && events_step<is>(rest, sink))...};
+                (void)steps;
+
+                if (ok)
+                    return rest;
+                else
+                    return nothing;
+            }
+
+            template <size_t i, typename In, typename Sink>
+            bool events_step(In &rest, Sink &sink) const
             {
-                return detail::TupleParserImpl<0, Tuple<Ps...>, Common<ParserI<Ps>...>>::process(ps, in);
+                const auto res = detail::parse_events(get<i>(ps), rest, sink, 0);
+
+                if (!res)
+                    return false;
+
+                rest = res.value();
+                return true;
+            }
+
+            // Incomplete as soon as one of the parsers is, as the next ones would start past the end of the input
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, Tuple<CallParserO<Ps, In>...>>
+            {
+                return partial_impl<Tuple<CallParserO<Ps, In>...>>(in, std::index_sequence_for<Ps...>{});
+            }
+
+            template <typename Out, typename In, size_t... is>
+            auto partial_impl(const In &in, std::index_sequence<is...>) const -> Partial<In, Out>
+            {
+                detail::TupleSlots<std::index_sequence<is...>, CallParserO<Ps, In>...> slots;
+                In rest = in;
+                PartialStatus status = PartialStatus::Matched;
+
+                const bool steps[] = {true, (status == PartialStatus::Matched && partial_step<is>(rest, slots, status))...};
+                (void)steps;
+
+                if (status != PartialStatus::Matched)
+                    return Partial<In, Out>{status, nothing};
+                else
+                    return Partial<In, Out>{status, tuple(rest, tuple(slots.template output<is>()...))};
+            }
+
+            template <size_t i, typename In, typename Slots>
+            bool partial_step(In &rest, Slots &slots, PartialStatus &status) const
+            {
+                const auto res = detail::parse_partial(get<i>(ps), rest, 0);
+
+                status = res.status;
+                if (status != PartialStatus::Matched)
+                    return false;
+
+                slots.template set<i>(snd(res.parsed.value()));
+                rest = fst(res.parsed.value());
+                return true;
+            }
+
+            // Runs of fixed width parsers are only compared, and their outputs never loaded
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return skim_impl(in, std::index_sequence_for<Ps...>{});
+            }
+
+            template <typename In, size_t... is>
+            auto skim_impl(const In &in, std::index_sequence<is...>) const -> Maybe<In>
+            {
+                In rest = in;
+                bool ok = true;
+
+                const bool steps[] = {true, (ok = ok && skim_step<is>(rest, Role<is>{}))...};
+                (void)steps;
+
+                if (ok)
+                    return rest;
+                else
+                    return nothing;
+            }
+
+            template <size_t i, typename In>
+            bool skim_step(In &rest, std::integral_constant<int, 0>) const
+            {
+                const auto res = detail::parse_skim(get<i>(ps), rest, 0);
+
+                if (!res)
+                    return false;
+
+                rest = res.value();
+                return true;
+            }
+
+            template <size_t i, typename In>
+            bool skim_step(In &rest, std::integral_constant<int, 1>) const
+            {
+                using Run = std::make_index_sequence<detail::fixed_run_length<IsFixedWidth<Ps>::value...>(i)>;
+
+                if (!run_matches<i>(rest, Run{}))
+                    return false;
+
+                rest = drop(run_width<i>(Run{}), rest);
+                return true;
+            }
+
+            // Dropped along with the start of its run
+            template <size_t i, typename In>
+            bool skim_step(In &, std::integral_constant<int, 2>) const
+            {
+                return true;
+            }
+
+            template <size_t i, size_t... js>
+            constexpr size_t run_width(std::index_sequence<js...>) const
+            {
+                const size_t widths[] = {get<i + js>(ps).width()...};
+
+                size_t width = 0;
+                for (const size_t w : widths)
+                    width += w;
+                return width;
             }
         };
 
         template <typename... Ps>
-        auto tpl(const Ps &...ps)
+        constexpr auto tpl(const Ps &...ps)
             -> TupleParser<FuncToFuncPtr<Ps>...>
         {
-            return TupleParser<FuncToFuncPtr<Ps>...>{tuple(ps...)};
+            return TupleParser<FuncToFuncPtr<Ps>...>(tuple(ps...));
         }
+
+        template <typename P, typename... Ps>
+        struct FirstByte<TupleParser<P, Ps...>> : FirstByte<P>
+        {
+        };
+
+        template <typename... Ps>
+        struct Backtracks<TupleParser<Ps...>> : detail::AnyOf<Backtracks<Ps>::value...>
+        {
+        };
+
+        template <typename... Ps>
+        struct ReportsOnMatch<TupleParser<Ps...>> : std::false_type
+        {
+        };
+
+        // SkipParser
+        // Runs the parser and discards its output
+
+        template <typename P>
+        struct SkipParser : ParserBase<SkipParser<P>>
+        {
+            P p;
+
+            constexpr explicit SkipParser(const P &p)
+                : p(p) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, Skipped>
+            {
+                const auto res = p(in);
+
+                if (!res)
+                    return nothing;
+                else
+                    return tuple(fst(res.value()), Skipped{});
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, Skipped>
+            {
+                const auto res = detail::parse_partial(p, in, 0);
+
+                if (!res)
+                    return Partial<In, Skipped>{res.status, nothing};
+                else
+                    return Partial<In, Skipped>{res.status, tuple(fst(res.parsed.value()), Skipped{})};
+            }
+
+            // Runs p in event mode as well, so that its output is not even built
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &) const -> Maybe<In>
+            {
+                detail::NullSink null;
+                return detail::parse_events(p, in, null, 0);
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::parse_skim(p, in, 0);
+            }
+        };
+
+        template <typename P>
+        constexpr auto skip(const P &p)
+            -> SkipParser<FuncToFuncPtr<P>>
+        {
+            return SkipParser<FuncToFuncPtr<P>>(p);
+        }
+
+        template <typename P>
+        struct FirstByte<SkipParser<P>> : FirstByte<P>
+        {
+        };
+
+        template <typename P>
+        struct Backtracks<SkipParser<P>> : Backtracks<P>
+        {
+        };
+
+        // PrecededParser
+        // Matches p1 then p2, and returns the output of p2
+
+        template <typename P1, typename P2>
+        struct PrecededParser : ParserBase<PrecededParser<P1, P2>>
+        {
+            P1 p1;
+            P2 p2;
+
+            constexpr PrecededParser(const P1 &p1, const P2 &p2)
+                : p1(p1), p2(p2) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, CallParserO<P2, In>>
+            {
+                const auto res1 = p1(in);
+
+                if (!res1)
+                    return nothing;
+                else
+                    return p2(fst(res1.value()));
+            }
+
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                detail::NullSink null;
+                const auto res1 = detail::parse_events(p1, in, null, 0);
+
+                if (!res1)
+                    return nothing;
+                else
+                    return detail::parse_events(p2, res1.value(), sink, 0);
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                const auto res1 = detail::parse_skim(p1, in, 0);
+
+                if (!res1)
+                    return nothing;
+                else
+                    return detail::parse_skim(p2, res1.value(), 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, CallParserO<P2, In>>
+            {
+                const auto res1 = detail::parse_partial(p1, in, 0);
+
+                if (!res1)
+                    return Partial<In, CallParserO<P2, In>>{res1.status, nothing};
+                else
+                    return detail::parse_partial(p2, fst(res1.parsed.value()), 0);
+            }
+        };
+
+        template <typename P1, typename P2>
+        constexpr auto preceded(const P1 &p1, const P2 &p2)
+            -> PrecededParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>>
+        {
+            return PrecededParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>>(p1, p2);
+        }
+
+        template <typename P1, typename P2>
+        struct FirstByte<PrecededParser<P1, P2>> : FirstByte<P1>
+        {
+        };
+
+        template <typename P1, typename P2>
+        struct Backtracks<PrecededParser<P1, P2>> : detail::AnyOf<Backtracks<P1>::value, Backtracks<P2>::value>
+        {
+        };
+
+        template <typename P1, typename P2>
+        struct ReportsOnMatch<PrecededParser<P1, P2>> : std::false_type
+        {
+        };
+
+        // TerminatedParser
+        // Matches p1 then p2, and returns the output of p1
+
+        template <typename P1, typename P2>
+        struct TerminatedParser : ParserBase<TerminatedParser<P1, P2>>
+        {
+            P1 p1;
+            P2 p2;
+
+            constexpr TerminatedParser(const P1 &p1, const P2 &p2)
+                : p1(p1), p2(p2) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, CallParserO<P1, In>>
+            {
+                const auto res1 = p1(in);
+                if (!res1)
+                    return nothing;
+
+                const auto res2 = p2(fst(res1.value()));
+                if (!res2)
+                    return nothing;
+
+                return tuple(fst(res2.value()), snd(res1.value()));
+            }
+
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                const auto res1 = detail::parse_events(p1, in, sink, 0);
+                if (!res1)
+                    return nothing;
+
+                detail::NullSink null;
+                return detail::parse_events(p2, res1.value(), null, 0);
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                const auto res1 = detail::parse_skim(p1, in, 0);
+
+                if (!res1)
+                    return nothing;
+                else
+                    return detail::parse_skim(p2, res1.value(), 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, CallParserO<P1, In>>
+            {
+                using Out = Partial<In, CallParserO<P1, In>>;
+
+                const auto res1 = detail::parse_partial(p1, in, 0);
+                if (!res1)
+                    return Out{res1.status, nothing};
+
+                const auto res2 = detail::parse_partial(p2, fst(res1.parsed.value()), 0);
+                if (!res2)
+                    return Out{res2.status, nothing};
+
+                return Out{PartialStatus::Matched, tuple(fst(res2.parsed.value()), snd(res1.parsed.value()))};
+            }
+        };
+
+        template <typename P1, typename P2>
+        constexpr auto terminated(const P1 &p1, const P2 &p2)
+            -> TerminatedParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>>
+        {
+            return TerminatedParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>>(p1, p2);
+        }
+
+        template <typename P1, typename P2>
+        struct FirstByte<TerminatedParser<P1, P2>> : FirstByte<P1>
+        {
+        };
+
+        template <typename P1, typename P2>
+        struct Backtracks<TerminatedParser<P1, P2>> : detail::AnyOf<Backtracks<P1>::value, Backtracks<P2>::value>
+        {
+        };
+
+        template <typename P1, typename P2>
+        struct ReportsOnMatch<TerminatedParser<P1, P2>> : std::false_type
+        {
+        };
+
+        // DelimitedParser
+        // Matches p1, p2 then p3, and returns the output of p2
+
+        template <typename P1, typename P2, typename P3>
+        struct DelimitedParser : ParserBase<DelimitedParser<P1, P2, P3>>
+        {
+            P1 p1;
+            P2 p2;
+            P3 p3;
+
+            constexpr DelimitedParser(const P1 &p1, const P2 &p2, const P3 &p3)
+                : p1(p1), p2(p2), p3(p3) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, CallParserO<P2, In>>
+            {
+                const auto res1 = p1(in);
+                if (!res1)
+                    return nothing;
+
+                const auto res2 = p2(fst(res1.value()));
+                if (!res2)
+                    return nothing;
+
+                const auto res3 = p3(fst(res2.value()));
+                if (!res3)
+                    return nothing;
+
+                return tuple(fst(res3.value()), snd(res2.value()));
+            }
+
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                detail::NullSink null;
+
+                const auto res1 = detail::parse_events(p1, in, null, 0);
+                if (!res1)
+                    return nothing;
+
+                const auto res2 = detail::parse_events(p2, res1.value(), sink, 0);
+                if (!res2)
+                    return nothing;
+
+                return detail::parse_events(p3, res2.value(), null, 0);
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                const auto res1 = detail::parse_skim(p1, in, 0);
+                if (!res1)
+                    return nothing;
+
+                const auto res2 = detail::parse_skim(p2, res1.value(), 0);
+                if (!res2)
+                    return nothing;
+
+                return detail::parse_skim(p3, res2.value(), 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, CallParserO<P2, In>>
+            {
+                using Out = Partial<In, CallParserO<P2, In>>;
+
+                const auto res1 = detail::parse_partial(p1, in, 0);
+                if (!res1)
+                    return Out{res1.status, nothing};
+
+                const auto res2 = detail::parse_partial(p2, fst(res1.parsed.value()), 0);
+                if (!res2)
+                    return Out{res2.status, nothing};
+
+                const auto res3 = detail::parse_partial(p3, fst(res2.parsed.value()), 0);
+                if (!res3)
+                    return Out{res3.status, nothing};
+
+                return Out{PartialStatus::Matched, tuple(fst(res3.parsed.value()), snd(res2.parsed.value()))};
+            }
+        };
+
+        template <typename P1, typename P2, typename P3>
+        constexpr auto delimited(const P1 &p1, const P2 &p2, const P3 &p3)
+            -> DelimitedParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>, FuncToFuncPtr<P3>>
+        {
+            return DelimitedParser<FuncToFuncPtr<P1>, FuncToFuncPtr<P2>, FuncToFuncPtr<P3>>(p1, p2, p3);
+        }
+
+        template <typename P1, typename P2, typename P3>
+        struct FirstByte<DelimitedParser<P1, P2, P3>> : FirstByte<P1>
+        {
+        };
+
+        template <typename P1, typename P2, typename P3>
+        struct Backtracks<DelimitedParser<P1, P2, P3>>
+            : detail::AnyOf<Backtracks<P1>::value, Backtracks<P2>::value, Backtracks<P3>::value>
+        {
+        };
+
+        template <typename P1, typename P2, typename P3>
+        struct ReportsOnMatch<DelimitedParser<P1, P2, P3>> : std::false_type
+        {
+        };
+
+        // SeparatedParser
+        // Matches zero or more p separated by sep, and returns the number of them.
+        // The outputs are discarded, so nothing is materialized however long the list is.
+        // A trailing separator is left unconsumed.
+        // The list ends at a separator and element that together consume nothing, which would otherwise repeat forever.
+
+        template <typename Sep, typename P>
+        struct SeparatedParser : ParserBase<SeparatedParser<Sep, P>>
+        {
+            Sep sep;
+            P p;
+
+            constexpr SeparatedParser(const Sep &sep, const P &p)
+                : sep(sep), p(p) {}
+
+            template <typename In>
+            auto parse(const In &in) const
+                -> Parsed<In, size_t>
+            {
+                const auto first = p(in);
+                if (!first)
+                    return tuple(in, size_t(0));
+
+                In rest = fst(first.value());
+                size_t count = 1;
+
+                while (true)
+                {
+                    const auto res_sep = sep(rest);
+                    if (!res_sep)
+                        break;
+
+                    const auto res = p(fst(res_sep.value()));
+                    if (!res || length(fst(res.value())) == length(rest))
+                        break;
+
+                    rest = fst(res.value());
+                    ++count;
+                }
+
+                return tuple(rest, count);
+            }
+
+            // Reports the elements, not the count. An element matched only in part reports nothing.
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                const auto first = detail::parse_events_on_match(p, in, sink);
+                if (!first)
+                    return in;
+
+                In rest = first.value();
+                detail::NullSink null;
+
+                while (true)
+                {
+                    const auto res_sep = detail::parse_events(sep, rest, null, 0);
+                    if (!res_sep)
+                        break;
+
+                    // An element after an empty separator is skimmed first, so that one ending the list is never reported.
+                    if (length(res_sep.value()) == length(rest))
+                    {
+                        const auto skimmed = detail::parse_skim(p, rest, 0);
+                        if (!skimmed || length(skimmed.value()) == length(rest))
+                            break;
+                    }
+
+                    const auto res = detail::parse_events_on_match(p, res_sep.value(), sink);
+                    if (!res)
+                        break;
+
+                    rest = res.value();
+                }
+
+                return rest;
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                const auto first = detail::parse_skim(p, in, 0);
+                if (!first)
+                    return in;
+
+                In rest = first.value();
+
+                while (true)
+                {
+                    const auto res_sep = detail::parse_skim(sep, rest, 0);
+                    if (!res_sep)
+                        break;
+
+                    const auto res = detail::parse_skim(p, res_sep.value(), 0);
+                    if (!res || length(res.value()) == length(rest))
+                        break;
+
+                    rest = res.value();
+                }
+
+                return rest;
+            }
+
+            // Incomplete while the separator or the element after it is, as the list could go on
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, size_t>
+            {
+                using Out = Partial<In, size_t>;
+
+                const auto first = detail::parse_partial(p, in, 0);
+                if (first.status == PartialStatus::Incomplete)
+                    return detail::partial_incomplete<In, size_t>();
+                if (!first)
+                    return Out{PartialStatus::Matched, tuple(in, size_t(0))};
+
+                In rest = fst(first.parsed.value());
+                size_t count = 1;
+
+                while (true)
+                {
+                    const auto res_sep = detail::parse_partial(sep, rest, 0);
+                    if (res_sep.status == PartialStatus::Incomplete)
+                        return detail::partial_incomplete<In, size_t>();
+                    if (!res_sep)
+                        break;
+
+                    const auto res = detail::parse_partial(p, fst(res_sep.parsed.value()), 0);
+                    if (res.status == PartialStatus::Incomplete)
+                        return detail::partial_incomplete<In, size_t>();
+                    if (!res || length(fst(res.parsed.value())) == length(rest))
+                        break;
+
+                    rest = fst(res.parsed.value());
+                    ++count;
+                }
+
+                return Out{PartialStatus::Matched, tuple(rest, count)};
+            }
+        };
+
+        template <typename Sep, typename P>
+        constexpr auto separated0(const Sep &sep, const P &p)
+            -> SeparatedParser<FuncToFuncPtr<Sep>, FuncToFuncPtr<P>>
+        {
+            return SeparatedParser<FuncToFuncPtr<Sep>, FuncToFuncPtr<P>>(sep, p);
+        }
+
+        template <typename Sep, typename P>
+        struct Backtracks<SeparatedParser<Sep, P>> : std::true_type
+        {
+        };
+
+        // MapParser
+        // Matches p, and returns f applied to its output.
+        // The output of p is moved into f, and the result of f is moved into the result, with no copy of either.
+
+        template <typename P, typename F>
+        struct MapParser : ParserBase<MapParser<P, F>>
+        {
+            P p;
+            F f;
+
+            constexpr MapParser(const P &p, const F &f)
+                : p(p), f(f) {}
+
+            template <typename In>
+            using Output = typename std::decay<decltype(std::declval<const F &>()(std::declval<CallParserO<P, In>>()))>::type;
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, Output<In>>
+            {
+                auto res = p(in);
+
+                if (!res)
+                    return nothing;
+                else
+                    return tuple(fst(res.value()), f(std::move(snd(res.value()))));
+            }
+
+            // f could not make it fail, so it is not called
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::parse_skim(p, in, 0);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const
+                -> Partial<In, Output<In>>
+            {
+                using Out = Partial<In, Output<In>>;
+
+                auto res = detail::parse_partial(p, in, 0);
+
+                if (!res)
+                    return Out{res.status, nothing};
+                else
+                    return Out{res.status, tuple(fst(res.parsed.value()), f(std::move(snd(res.parsed.value()))))};
+            }
+        };
+
+        template <typename P, typename F>
+        constexpr auto map(const P &p, const F &f)
+            -> MapParser<FuncToFuncPtr<P>, FuncToFuncPtr<F>>
+        {
+            return MapParser<FuncToFuncPtr<P>, FuncToFuncPtr<F>>(p, f);
+        }
+
+        template <typename P, typename F>
+        struct FirstByte<MapParser<P, F>> : FirstByte<P>
+        {
+        };
+
+        template <typename P, typename F>
+        struct Backtracks<MapParser<P, F>> : Backtracks<P>
+        {
+        };
+
+        // MapResParser
+        // Matches p, and returns f applied to its output, where f may fail by returning nothing.
+        // As f decides the match, it is parsed in full in skim mode as well.
+
+        template <typename P, typename F>
+        struct MapResParser : ParserBase<MapResParser<P, F>>
+        {
+            P p;
+            F f;
+
+            constexpr MapResParser(const P &p, const F &f)
+                : p(p), f(f) {}
+
+            template <typename In>
+            using Output = EnumAt<1, typename std::decay<decltype(std::declval<const F &>()(std::declval<CallParserO<P, In>>()))>::type>;
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, Output<In>>
+            {
+                auto res = p(in);
+                if (!res)
+                    return nothing;
+
+                auto mapped = f(std::move(snd(res.value())));
+                if (!mapped)
+                    return nothing;
+
+                return tuple(fst(res.value()), std::move(mapped.value()));
+            }
+
+            // f only decides a match of p, which no more input could change
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, Output<In>>
+            {
+                using Out = Partial<In, Output<In>>;
+
+                auto res = detail::parse_partial(p, in, 0);
+                if (!res)
+                    return Out{res.status, nothing};
+
+                auto mapped = f(std::move(snd(res.parsed.value())));
+                if (!mapped)
+                    return Out{PartialStatus::Failed, nothing};
+
+                return Out{PartialStatus::Matched, tuple(fst(res.parsed.value()), std::move(mapped.value()))};
+            }
+        };
+
+        template <typename P, typename F>
+        constexpr auto map_res(const P &p, const F &f)
+            -> MapResParser<FuncToFuncPtr<P>, FuncToFuncPtr<F>>
+        {
+            return MapResParser<FuncToFuncPtr<P>, FuncToFuncPtr<F>>(p, f);
+        }
+
+        template <typename P, typename F>
+        struct FirstByte<MapResParser<P, F>> : FirstByte<P>
+        {
+        };
+
+        template <typename P, typename F>
+        struct Backtracks<MapResParser<P, F>> : Backtracks<P>
+        {
+        };
+
+        // ValueParser
+        // Matches p, and returns v instead of its output
+
+        template <typename P, typename V>
+        struct ValueParser : ParserBase<ValueParser<P, V>>
+        {
+            P p;
+            V v;
+
+            constexpr ValueParser(const P &p, const V &v)
+                : p(p), v(v) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, V>
+            {
+                const auto res = p(in);
+
+                if (!res)
+                    return nothing;
+                else
+                    return tuple(fst(res.value()), v);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, V>
+            {
+                const auto res = detail::parse_partial(p, in, 0);
+
+                if (!res)
+                    return Partial<In, V>{res.status, nothing};
+                else
+                    return Partial<In, V>{res.status, tuple(fst(res.parsed.value()), v)};
+            }
+
+            // The output of p is not even built
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                detail::NullSink null;
+                const auto res = detail::parse_events(p, in, null, 0);
+
+                if (res)
+                    detail::report(sink, v);
+
+                return res;
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::parse_skim(p, in, 0);
+            }
+        };
+
+        template <typename P, typename V>
+        constexpr auto value(const P &p, const V &v)
+            -> ValueParser<FuncToFuncPtr<P>, V>
+        {
+            return ValueParser<FuncToFuncPtr<P>, V>(p, v);
+        }
+
+        template <typename P, typename V>
+        struct FirstByte<ValueParser<P, V>> : FirstByte<P>
+        {
+        };
+
+        template <typename P, typename V>
+        struct Backtracks<ValueParser<P, V>> : Backtracks<P>
+        {
+        };
+
+        // VerifyParser
+        // Matches p only if its output satisfies pred.
+        // As pred decides the match, it is parsed in full in skim mode as well.
+
+        template <typename P, typename Pred>
+        struct VerifyParser : ParserBase<VerifyParser<P, Pred>>
+        {
+            P p;
+            Pred pred;
+
+            constexpr VerifyParser(const P &p, const Pred &pred)
+                : p(p), pred(pred) {}
+
+            template <typename In>
+            constexpr auto parse(const In &in) const
+                -> Parsed<In, CallParserO<P, In>>
+            {
+                auto res = p(in);
+
+                if (res && pred(snd(res.value())))
+                    return res;
+                else
+                    return nothing;
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, CallParserO<P, In>>
+            {
+                auto res = detail::parse_partial(p, in, 0);
+
+                if (res && !pred(snd(res.parsed.value())))
+                    return Partial<In, CallParserO<P, In>>{PartialStatus::Failed, nothing};
+                else
+                    return res;
+            }
+        };
+
+        template <typename P, typename Pred>
+        constexpr auto verify(const P &p, const Pred &pred)
+            -> VerifyParser<FuncToFuncPtr<P>, FuncToFuncPtr<Pred>>
+        {
+            return VerifyParser<FuncToFuncPtr<P>, FuncToFuncPtr<Pred>>(p, pred);
+        }
+
+        template <typename P, typename Pred>
+        struct FirstByte<VerifyParser<P, Pred>> : FirstByte<P>
+        {
+        };
+
+        template <typename P, typename Pred>
+        struct Backtracks<VerifyParser<P, Pred>> : Backtracks<P>
+        {
+        };
+
+        // EventParser
+        // Same as p, except that in event mode its match is surrounded by start(Tag{}) and end(Tag{}).
+        // start is deferred until p reports its first event, so p failing on its first parser reports nothing.
+        // Should p fail after it reported, end is still reported, so that the starts and ends of a sink stay paired.
+
+        template <typename Tag, typename P>
+        struct EventParser : ParserBase<EventParser<Tag, P>>
+        {
+            P p;
+
+            constexpr explicit EventParser(const P &p)
+                : p(p) {}
+
+            template <typename In>
+            auto parse(const In &in) const
+                -> Parsed<In, CallParserO<P, In>>
+            {
+                return p(in);
+            }
+
+            template <typename In>
+            auto parse_partial(const In &in) const -> Partial<In, CallParserO<P, In>>
+            {
+                return detail::parse_partial(p, in, 0);
+            }
+
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, detail::EventBuffer<Sink> &buffer) const -> Maybe<In>
+            {
+                const size_t position = buffer.position();
+                buffer.template defer_start<Tag>();
+
+                const auto res = detail::parse_events(p, in, buffer, 0);
+                if (!res)
+                {
+                    if (buffer.reported(position))
+                        buffer.end(Tag{});
+                    else
+                        buffer.truncate(position);
+                    return nothing;
+                }
+
+                buffer.end(Tag{});
+                return res;
+            }
+
+            template <typename In, typename Sink>
+            auto parse_events(const In &in, Sink &sink) const -> Maybe<In>
+            {
+                detail::EventBuffer<Sink> buffer(sink);
+                const auto res = parse_events(in, buffer);
+                buffer.flush();
+
+                return res;
+            }
+
+            template <typename In>
+            auto parse_events(const In &in, detail::NullSink &null) const -> Maybe<In>
+            {
+                return detail::parse_events(p, in, null, 0);
+            }
+
+            template <typename In>
+            auto parse_skim(const In &in) const -> Maybe<In>
+            {
+                return detail::parse_skim(p, in, 0);
+            }
+        };
+
+        template <typename Tag, typename P>
+        constexpr auto event(const P &p)
+            -> EventParser<Tag, FuncToFuncPtr<P>>
+        {
+            return EventParser<Tag, FuncToFuncPtr<P>>(p);
+        }
+
+        template <typename Tag, typename P>
+        struct FirstByte<EventParser<Tag, P>> : FirstByte<P>
+        {
+        };
+
+        template <typename Tag, typename P>
+        struct Backtracks<EventParser<Tag, P>> : Backtracks<P>
+        {
+        };
+
+        template <typename Tag, typename P>
+        struct ReportsOnMatch<EventParser<Tag, P>> : ReportsOnMatch<P>
+        {
+        };
+
+        // Rule
+        // Type-erased parser handle for recursive grammars.
+        // A Rule could be declared first and defined later, and refered inside of its own definition by ref().
+        // The parser is stored in place without heap allocation, and called by a single indirect call.
+        // Skim mode has its own indirect call, so the parser skims as it would outside of the Rule.
+        // Given a Sink, event mode has one as well, so the parser reports its events to that Sink through the Rule as
+        // it would outside of it. Without one, the Rule reports its output as a single value.
+        // Given partial, partial mode has one too, for which the parser must be able to run in partial mode.
+        // Defining a Rule is not synchronized. It must be defined before it is shared by threads.
+
+        template <typename In, typename Out, size_t capacity = 64, typename Sink = void, bool partial = false>
+        class Rule
+        {
+            // Sink of the indirect call of event mode, which no parser reports to without a Sink
+            struct NoSink
+            {
+            };
+
+            using EventSink = typename std::conditional<std::is_void<Sink>::value, NoSink, Sink>::type;
+
+        public:
+            Rule()
+                : call_(&undefined),
+                  skim_(&undefined_skim),
+                  events_(&undefined_events),
+                  partial_(&undefined_partial),
+                  destroy_(&trivial) {}
+
+            Rule(const Rule &) = delete;
+            Rule &operator=(const Rule &) = delete;
+
+            ~Rule()
+            {
+                destroy_(storage_);
+            }
+
+            template <typename P>
+            Rule &operator=(const P &p)
+            {
+                using Stored = FuncToFuncPtr<P>;
+
+                static_assert(sizeof(Stored) <= capacity, "Parser does not fit in the Rule. Increase the capacity.");
+                static_assert(alignof(Stored) <= alignof(std::max_align_t), "Parser is over-aligned for the Rule.");
+
+                // Copied first, as p could be a part of the stored parser. Should the copy into the storage throw,
+                // the rule is left undefined rather than holding a destroyed parser.
+                const Stored stored(p);
+                reset();
+                new (storage_) Stored(stored);
+                call_ = &invoke<Stored>;
+                skim_ = &invoke_skim<Stored>;
+                events_ = events_of<Stored>(std::is_void<Sink>{});
+                partial_ = partial_of<Stored>(std::integral_constant<bool, partial>{});
+                destroy_ = &destroy<Stored>;
+
+                return *this;
+            }
+
+            auto operator()(const In &in) const
+                -> Parsed<In, Out>
+            {
+                return call_(storage_, in);
+            }
+
+            auto parse_skim(const In &in) const
+                -> Maybe<In>
+            {
+                return skim_(storage_, in);
+            }
+
+            auto parse_events(const In &in, detail::EventBuffer<EventSink> &buffer) const
+                -> Maybe<In>
+            {
+                return events_(storage_, in, buffer);
+            }
+
+            auto parse_events(const In &in, EventSink &sink) const
+                -> Maybe<In>
+            {
+                detail::EventBuffer<EventSink> buffer(sink);
+                const auto res = events_(storage_, in, buffer);
+                buffer.flush();
+
+                return res;
+            }
+
+            template <bool enabled = partial>
+            auto parse_partial(const In &in) const
+                -> typename std::enable_if<enabled, Partial<In, Out>>::type
+            {
+                return partial_(storage_, in);
+            }
+
+        private:
+            using Events = Maybe<In> (*)(const void *, const In &, detail::EventBuffer<EventSink> &);
+            using PartialCall = Partial<In, Out> (*)(const void *, const In &);
+
+            template <typename P>
+            static auto invoke(const void *p, const In &in)
+                -> Parsed<In, Out>
+            {
+                return (*static_cast<const P *>(p))(in);
+            }
+
+            template <typename P>
+            static auto invoke_skim(const void *p, const In &in)
+                -> Maybe<In>
+            {
+                return detail::parse_skim(*static_cast<const P *>(p), in, 0);
+            }
+
+            template <typename P>
+            static auto invoke_events(const void *p, const In &in, detail::EventBuffer<EventSink> &buffer)
+                -> Maybe<In>
+            {
+                return detail::parse_events(*static_cast<const P *>(p), in, buffer, 0);
+            }
+
+            template <typename P>
+            static Events events_of(std::false_type)
+            {
+                return &invoke_events<P>;
+            }
+
+            template <typename P>
+            static Events events_of(std::true_type)
+            {
+                return &undefined_events;
+            }
+
+            template <typename P>
+            static auto invoke_partial(const void *p, const In &in)
+                -> Partial<In, Out>
+            {
+                return detail::parse_partial(*static_cast<const P *>(p), in, 0);
+            }
+
+            template <typename P>
+            static PartialCall partial_of(std::true_type)
+            {
+                return &invoke_partial<P>;
+            }
+
+            template <typename P>
+            static PartialCall partial_of(std::false_type)
+            {
+                return &undefined_partial;
+            }
+
+            template <typename P>
+            static void destroy(void *p)
+            {
+                static_cast<P *>(p)->~P();
+            }
+
+            // Undefined rule never matches
+            static auto undefined(const void *, const In &)
+                -> Parsed<In, Out>
+            {
+                return nothing;
+            }
+
+            static auto undefined_skim(const void *, const In &)
+                -> Maybe<In>
+            {
+                return nothing;
+            }
+
+            static auto undefined_events(const void *, const In &, detail::EventBuffer<EventSink> &)
+                -> Maybe<In>
+            {
+                return nothing;
+            }
+
+            static auto undefined_partial(const void *, const In &)
+                -> Partial<In, Out>
+            {
+                return Partial<In, Out>{PartialStatus::Failed, nothing};
+            }
+
+            static void trivial(void *) {}
+
+            void reset()
+            {
+                const auto destroy = destroy_;
+                call_ = &undefined;
+                skim_ = &undefined_skim;
+                events_ = &undefined_events;
+                partial_ = &undefined_partial;
+                destroy_ = &trivial;
+                destroy(storage_);
+            }
+
+            alignas(std::max_align_t) unsigned char storage_[capacity];
+            Parsed<In, Out> (*call_)(const void *, const In &);
+            Maybe<In> (*skim_)(const void *, const In &);
+            Events events_;
+            PartialCall partial_;
+            void (*destroy_)(void *);
+        };
+
+        // RuleRef
+        // Non-owning reference to a Rule, to be used inside of combinators.
+
+        template <typename In, typename Out, size_t capacity, typename Sink = void, bool partial = false>
+        struct RuleRef
+        {
+            const Rule<In, Out, capacity, Sink, partial> *rule;
+
+            auto operator()(const In &in) const
+                -> Parsed<In, Out>
+            {
+                return (*rule)(in);
+            }
+
+            auto parse_skim(const In &in) const
+                -> Maybe<In>
+            {
+                return rule->parse_skim(in);
+            }
+
+            // On the Sink of the Rule, and on the buffer of a hold in front of it
+            template <typename S>
+            auto parse_events(const In &in, S &sink) const
+                -> decltype(std::declval<const Rule<In, Out, capacity, Sink, partial> &>().parse_events(in, sink))
+            {
+                return rule->parse_events(in, sink);
+            }
+
+            // Discarded events are only a match
+            auto parse_events(const In &in, detail::NullSink &) const
+                -> Maybe<In>
+            {
+                return rule->parse_skim(in);
+            }
+
+            template <bool enabled = partial>
+            auto parse_partial(const In &in) const
+                -> typename std::enable_if<enabled, Partial<In, Out>>::type
+            {
+                return rule->parse_partial(in);
+            }
+        };
+
+        template <typename In, typename Out, size_t capacity, typename Sink, bool partial>
+        auto ref(const Rule<In, Out, capacity, Sink, partial> &rule)
+            -> RuleRef<In, Out, capacity, Sink, partial>
+        {
+            return RuleRef<In, Out, capacity, Sink, partial>{&rule};
+        }
+
+        // A Rule given a Sink reports the events of its parser, which could fail after it reported
+        template <typename In, typename Out, size_t capacity, typename Sink, bool partial>
+        struct ReportsOnMatch<RuleRef<In, Out, capacity, Sink, partial>> : std::is_void<Sink>
+        {
+        };
     }
 
 }
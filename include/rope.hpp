@@ -0,0 +1,181 @@
+#ifndef EFP_ROPE_HPP_
+#define EFP_ROPE_HPP_
+
+#include "prelude.hpp"
+#include "string.hpp"
+
+namespace efp
+{
+    namespace parser
+    {
+        // Rope
+        // Character input over a chain of non-contiguous segments, such as the buffers of a network message.
+        // It is the part of the current segment, the head, and the segments after it, all bounded by the size.
+        // Access within the head is a single comparison more than StringView. Crossing into the next segments walks them.
+        // The segments must outlive the rope and its parts.
+
+        class Rope
+        {
+        public:
+            Rope()
+                : head_(), rest_(nullptr), size_(0) {}
+
+            explicit Rope(const StringView &in)
+                : head_(in), rest_(nullptr), size_(length(in)) {}
+
+            Rope(const StringView *segments, size_t count)
+                : head_(), rest_(segments), size_(0)
+            {
+                for (size_t i = 0; i < count; ++i)
+                    size_ += length(segments[i]);
+
+                if (size_ > 0)
+                    next_segment();
+            }
+
+            // The segments from rest are only read up to size in total
+            Rope(const StringView &head, const StringView *rest, size_t size)
+                : head_(head), rest_(rest), size_(size)
+            {
+                if (length(head_) == 0 && size_ > 0)
+                    next_segment();
+            }
+
+            // Part of the current segment in the rope
+            const StringView &head() const
+            {
+                return head_;
+            }
+
+            const StringView *rest() const
+            {
+                return rest_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            bool empty() const
+            {
+                return size_ == 0;
+            }
+
+            // True if the rope is within a single segment, and so is head() as a whole
+            bool contiguous() const
+            {
+                return length(head_) == size_;
+            }
+
+            const char &operator[](size_t i) const
+            {
+                return i < length(head_) ? head_[i] : at_rest(i - length(head_));
+            }
+
+            bool operator==(const StringView &other) const
+            {
+                if (size_ != length(other))
+                    return false;
+
+                for (size_t i = 0; i < size_; ++i)
+                {
+                    if ((*this)[i] != other[i])
+                        return false;
+                }
+                return true;
+            }
+
+            bool operator!=(const StringView &other) const
+            {
+                return !(*this == other);
+            }
+
+            // Copies the characters into out, which must hold size() of them
+            void copy_to(char *out) const
+            {
+                Rope r = *this;
+                while (!r.empty())
+                {
+                    const StringView &h = r.head();
+                    for (size_t i = 0; i < length(h); ++i)
+                        out[i] = h[i];
+                    out += length(h);
+                    r = r.drop_slow(length(h));
+                }
+            }
+
+            // Slow path of drop, for n of at least the length of the head
+            Rope drop_slow(size_t n) const
+            {
+                if (n >= size_)
+                    return Rope();
+
+                const size_t size = size_ - n;
+                n -= length(head_);
+
+                const StringView *rest = rest_;
+                while (n >= length(*rest))
+                {
+                    n -= length(*rest);
+                    ++rest;
+                }
+
+                return Rope(take(size, drop(n, *rest)), rest + 1, size);
+            }
+
+        private:
+            const char &at_rest(size_t i) const
+            {
+                const StringView *segment = rest_;
+                while (i >= length(*segment))
+                {
+                    i -= length(*segment);
+                    ++segment;
+                }
+                return (*segment)[i];
+            }
+
+            // Moves the head to the next non-empty segment, of which there is one as size_ > 0
+            void next_segment()
+            {
+                while (length(*rest_) == 0)
+                    ++rest_;
+
+                head_ = take(size_, *rest_);
+                ++rest_;
+            }
+
+            StringView head_;
+            const StringView *rest_;
+            size_t size_;
+        };
+
+        using efp::drop;
+        using efp::length;
+        using efp::take;
+
+        inline size_t length(const Rope &in)
+        {
+            return in.size();
+        }
+
+        inline Rope drop(size_t n, const Rope &in)
+        {
+            if (n < length(in.head()))
+                return Rope(drop(n, in.head()), in.rest(), in.size() - n);
+            else
+                return in.drop_slow(n);
+        }
+
+        inline Rope take(size_t n, const Rope &in)
+        {
+            if (n >= in.size())
+                return in;
+            else
+                return Rope(take(n, in.head()), in.rest(), n);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef EFP_STREAM_HPP_
+#define EFP_STREAM_HPP_
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "parser_base.hpp"
+#include "bytes_parser.hpp"
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#include <coroutine>
+#define EFP_PARSER_COROUTINE
+#endif
+
+// Streams of messages, as read from a non-blocking socket.
+// A framer finds where the next message ends in the bytes received so far, and tells apart a message which is
+// incomplete from one which could never be completed. Then the message is parsed as a whole by any parser.
+// MessageStream buffers only the bytes of the current message. The event loop feeds it what it reads, and the
+// messages are taken either by poll(p), or in C++20 by co_await next(p) which suspends until a message is complete.
+// A message without a delimiter or a length prefix is framed by its own parser, run in partial mode, which tells a
+// need for more input from a failure. So next(p) suspends wherever the input of p runs out, and resumes once the
+// bytes which decide its match arrived.
+
+namespace efp
+{
+    namespace parser
+    {
+        // FrameStatus
+        // Incomplete if more bytes could complete the frame, and Failed if none could
+
+        enum class FrameStatus : uint8_t
+        {
+            Incomplete,
+            Complete,
+            Failed,
+        };
+
+        // Frame
+        // A complete frame is the message in [begin, end) of the received bytes, followed by the next frame at next
+
+        struct Frame
+        {
+            FrameStatus status;
+            size_t begin;
+            size_t end;
+            size_t next;
+
+            static Frame incomplete()
+            {
+                return Frame{FrameStatus::Incomplete, 0, 0, 0};
+            }
+
+            static Frame failed()
+            {
+                return Frame{FrameStatus::Failed, 0, 0, 0};
+            }
+
+            static Frame complete(size_t begin, size_t end, size_t next)
+            {
+                return Frame{FrameStatus::Complete, begin, end, next};
+            }
+        };
+
+        // Framers
+        // frame(in, seen) runs on the received bytes of a frame, of which the first seen were already received at the
+        // previous call, so a scan could resume from there instead of the start.
+        // Once the stream closed, a framer may provide frame_closed(in) to decide on the bytes left, which are all
+        // there is of the frame.
+
+        // DelimiterFramer
+        // Message up to the delimiter, which is consumed but not a part of it
+
+        struct DelimiterFramer
+        {
+            StringView delimiter;
+            size_t max_length;
+
+            Frame frame(const StringView &in, size_t seen) const
+            {
+                const size_t n = length(in);
+                const size_t d = length(delimiter);
+
+                // A delimiter which started before seen would have been found at the previous call
+                size_t i = seen >= d ? seen - d + 1 : 0;
+                while (i + d <= n)
+                {
+                    const void *found = std::memchr(in.data() + i, delimiter[0], n - d + 1 - i);
+                    if (!found)
+                        break;
+
+                    i = static_cast<size_t>(static_cast<const char *>(found) - in.data());
+                    if (std::memcmp(in.data() + i, delimiter.data(), d) == 0)
+                        return Frame::complete(0, i, i + d);
+                    ++i;
+                }
+
+                return n >= max_length + d ? Frame::failed() : Frame::incomplete();
+            }
+        };
+
+        // The delimiter could not be empty, as its first byte is searched for
+        inline DelimiterFramer delimiter_framer(const StringView &delimiter, size_t max_length = 1 << 16)
+        {
+            assert(length(delimiter) > 0);
+            return DelimiterFramer{delimiter, max_length};
+        }
+
+        namespace detail
+        {
+            // Bytes within which a length prefix either matches or never will
+            template <typename P>
+            struct PrefixWidth;
+
+            template <typename T, bool big_endian>
+            struct PrefixWidth<BinaryParser<T, big_endian>> : std::integral_constant<size_t, sizeof(T)>
+            {
+            };
+
+            template <typename T>
+            struct PrefixWidth<VarintParser<T>> : std::integral_constant<size_t, (sizeof(T) * 8 + 6) / 7>
+            {
+            };
+        }
+
+        // LengthPrefixFramer
+        // Message of the length given by a binary or varint prefix, which is consumed but not a part of it
+
+        template <typename P>
+        struct LengthPrefixFramer
+        {
+            P prefix;
+            size_t max_length;
+
+            Frame frame(const StringView &in, size_t) const
+            {
+                const auto res = prefix(in);
+                if (!res)
+                    return length(in) < detail::PrefixWidth<P>::value ? Frame::incomplete() : Frame::failed();
+
+                const auto n = snd(res.value());
+                if (detail::is_negative(n) || static_cast<uint64_t>(n) > max_length)
+                    return Frame::failed();
+
+                const size_t begin = length(in) - length(fst(res.value()));
+                const size_t end = begin + static_cast<size_t>(n);
+                return end <= length(in) ? Frame::complete(begin, end, end) : Frame::incomplete();
+            }
+        };
+
+        template <typename P>
+        LengthPrefixFramer<P> length_prefix_framer(const P &prefix, size_t max_length = 1 << 16)
+        {
+            return LengthPrefixFramer<P>{prefix, max_length};
+        }
+
+        // ParserFramer
+        // Message matched by p, for the protocols with neither a delimiter nor a length prefix.
+        // p runs in partial mode from the start of the message at each call, as parsers keep no state between calls,
+        // and the message is complete once more bytes could not change its match. The message is then parsed again by
+        // the parser given to poll or next, which should match it as p did.
+        // A match of no bytes fails, as it would be taken again and again.
+
+        template <typename P>
+        struct ParserFramer
+        {
+            P p;
+            size_t max_length;
+
+            Frame frame(const StringView &in, size_t) const
+            {
+                const auto res = partial(p, in);
+
+                if (res.status == PartialStatus::Incomplete)
+                    return length(in) > max_length ? Frame::failed() : Frame::incomplete();
+
+                return matched(in, res.parsed);
+            }
+
+            // The bytes left are the whole message, which p parses as it would any input
+            Frame frame_closed(const StringView &in) const
+            {
+                return matched(in, p(in));
+            }
+
+            template <typename Res>
+            Frame matched(const StringView &in, const Res &res) const
+            {
+                if (!res)
+                    return Frame::failed();
+
+                const size_t end = length(in) - length(fst(res.value()));
+                if (end == 0 || end > max_length)
+                    return Frame::failed();
+
+                return Frame::complete(0, end, end);
+            }
+        };
+
+        template <typename P>
+        ParserFramer<P> parser_framer(const P &p, size_t max_length = 1 << 16)
+        {
+            return ParserFramer<P>{p, max_length};
+        }
+
+        namespace detail
+        {
+            template <typename Framer>
+            auto frame_closed(const Framer &framer, const StringView &in, int)
+                -> decltype(framer.frame_closed(in))
+            {
+                return framer.frame_closed(in);
+            }
+
+            // Otherwise a frame cut short by the end of the stream could never be completed
+            template <typename Framer>
+            Frame frame_closed(const Framer &, const StringView &, long)
+            {
+                return Frame::failed();
+            }
+        }
+
+        // StreamStatus
+        // Failed once a frame could not be completed or its message did not match, and Closed once the stream ended
+        // with no partial message left. No message is taken after either.
+
+        enum class StreamStatus : uint8_t
+        {
+            Open,
+            Failed,
+            Closed,
+        };
+
+        // MessageStream
+        // Messages of a stream, split by the framer and parsed by the parser given to each poll.
+        // A message is parsed only once it is complete, and it must be matched as a whole.
+        // The views in a message are valid until the next poll, next or feed.
+
+        template <typename Framer>
+        class MessageStream
+        {
+        public:
+            explicit MessageStream(const Framer &framer)
+                : framer_(framer), begin_(0), seen_(0), taken_(false), closed_(false), status_(StreamStatus::Open),
+                  frame_(Frame::incomplete())
+            {
+            }
+
+            MessageStream(const MessageStream &) = delete;
+            MessageStream &operator=(const MessageStream &) = delete;
+
+            StreamStatus status() const
+            {
+                return status_;
+            }
+
+            // Bytes received and not yet taken as a message
+            size_t buffered() const
+            {
+                return buffer_.size() - begin_ - (taken_ ? frame_.next : 0);
+            }
+
+            // Appends the bytes read from the stream
+            void feed(const char *data, size_t n)
+            {
+                if (status_ != StreamStatus::Open || closed_)
+                    return;
+
+                // Only the partial message is moved, as the taken ones are released first
+                if (begin_ > 0)
+                {
+                    buffer_.erase(0, begin_);
+                    begin_ = 0;
+                }
+                buffer_.append(data, n);
+
+                advance();
+            }
+
+            // Marks the end of the stream
+            void close()
+            {
+                closed_ = true;
+                advance();
+            }
+
+            // Takes the next message if it is complete
+            template <typename P>
+            auto poll(const P &p) -> Maybe<CallParserO<P, StringView>>
+            {
+                release();
+                frame_next();
+                return take_message(p);
+            }
+
+#if defined(EFP_PARSER_COROUTINE)
+            // Awaiter of the next message. Resumes with nothing once the stream failed or closed.
+            template <typename P>
+            struct NextMessage
+            {
+                MessageStream &stream;
+                P p;
+
+                bool await_ready()
+                {
+                    stream.release();
+                    stream.frame_next();
+                    return stream.frame_.status != FrameStatus::Incomplete || stream.status_ != StreamStatus::Open;
+                }
+
+                void await_suspend(std::coroutine_handle<> waiter)
+                {
+                    stream.waiter_ = waiter;
+                }
+
+                Maybe<CallParserO<P, StringView>> await_resume()
+                {
+                    return stream.take_message(p);
+                }
+            };
+
+            // Suspends the coroutine until feed or close completes the next message
+            template <typename P>
+            NextMessage<P> next(const P &p)
+            {
+                return NextMessage<P>{*this, p};
+            }
+#endif
+
+        private:
+            StringView received() const
+            {
+                return StringView(buffer_.data() + begin_, buffer_.size() - begin_);
+            }
+
+            // Forgets the last message taken
+            void release()
+            {
+                if (taken_)
+                {
+                    begin_ += frame_.next;
+                    seen_ = 0;
+                    taken_ = false;
+                    frame_ = Frame::incomplete();
+                }
+            }
+
+            void frame_next()
+            {
+                if (status_ != StreamStatus::Open || frame_.status != FrameStatus::Incomplete)
+                    return;
+
+                const StringView in = received();
+                frame_ = framer_.frame(in, seen_);
+                seen_ = length(in);
+
+                if (frame_.status == FrameStatus::Incomplete && closed_ && length(in) > 0)
+                    frame_ = detail::frame_closed(framer_, in, 0);
+
+                if (frame_.status == FrameStatus::Failed)
+                    status_ = StreamStatus::Failed;
+                else if (frame_.status == FrameStatus::Incomplete && closed_)
+                    status_ = length(in) == 0 ? StreamStatus::Closed : StreamStatus::Failed;
+            }
+
+            template <typename P>
+            auto take_message(const P &p) -> Maybe<CallParserO<P, StringView>>
+            {
+                if (frame_.status != FrameStatus::Complete || taken_)
+                    return nothing;
+
+                taken_ = true;
+                const auto res = p(take(frame_.end - frame_.begin, drop(frame_.begin, received())));
+                if (!res || length(fst(res.value())) > 0)
+                {
+                    status_ = StreamStatus::Failed;
+                    return nothing;
+                }
+                return snd(res.value());
+            }
+
+            // Frames the received bytes, and resumes the waiting coroutine if that decided the next message
+            void advance()
+            {
+                frame_next();
+
+#if defined(EFP_PARSER_COROUTINE)
+                if (waiter_ && (frame_.status != FrameStatus::Incomplete || status_ != StreamStatus::Open))
+                {
+                    // The coroutine may take more messages, or even end, before it returns here
+                    const auto waiter = waiter_;
+                    waiter_ = nullptr;
+                    waiter.resume();
+                }
+#endif
+            }
+
+            Framer framer_;
+            std::string buffer_;
+            size_t begin_;
+            size_t seen_;
+            bool taken_;
+            bool closed_;
+            StreamStatus status_;
+            Frame frame_;
+#if defined(EFP_PARSER_COROUTINE)
+            std::coroutine_handle<> waiter_;
+#endif
+        };
+    }
+}
+
+#endif
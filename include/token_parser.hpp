@@ -0,0 +1,160 @@
+#ifndef EFP_TOKEN_PARSER_HPP_
+#define EFP_TOKEN_PARSER_HPP_
+
+#include "parser_base.hpp"
+
+// Span: Input over a sequence of arbitrary elements, such as the tokens from a lexer.
+// token<T>: Matches a token of alternative T of an Enum, by comparing the alternative index only.
+// All the combinators and tag() work on Span as well.
+
+namespace efp
+{
+    namespace parser
+    {
+        // Span
+        // Non-owning view of a contiguous sequence of elements
+
+        template <typename A>
+        class Span
+        {
+        public:
+            Span()
+                : data_(nullptr), size_(0) {}
+
+            Span(const A *data, size_t size)
+                : data_(data), size_(size) {}
+
+            // From any contiguous container, e.g. Vector<A>
+            template <typename C>
+            explicit Span(const C &c)
+                : data_(c.data()), size_(c.size()) {}
+
+            const A *data() const
+            {
+                return data_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+
+            bool empty() const
+            {
+                return size_ == 0;
+            }
+
+            const A &operator[](size_t i) const
+            {
+                return data_[i];
+            }
+
+        private:
+            const A *data_;
+            size_t size_;
+        };
+
+        template <typename A>
+        size_t length(const Span<A> &in)
+        {
+            return in.size();
+        }
+
+        template <typename A>
+        Span<A> drop(size_t n, const Span<A> &in)
+        {
+            return Span<A>(in.data() + n, in.size() - n);
+        }
+
+        template <typename A>
+        Span<A> take(size_t n, const Span<A> &in)
+        {
+            return Span<A>(in.data(), n);
+        }
+
+        template <typename C>
+        auto span(const C &c)
+            -> Span<typename std::decay<decltype(*c.data())>::type>
+        {
+            return Span<typename std::decay<decltype(*c.data())>::type>(c);
+        }
+
+        namespace detail
+        {
+            // Index of alternative T in Enum E, or the number of alternatives if T is none of them
+            template <typename T, typename E>
+            struct FindAlternative
+            {
+            };
+
+            template <typename T, typename A, typename... As>
+            struct FindAlternative<T, Enum<A, As...>>
+                : std::integral_constant<size_t, std::is_same<T, A>::value ? 0 : 1 + FindAlternative<T, Enum<As...>>::value>
+            {
+            };
+
+            template <typename T>
+            struct FindAlternative<T, Enum<>> : std::integral_constant<size_t, 0>
+            {
+            };
+
+            // Index of alternative T in Enum E
+            template <typename T, typename E>
+            struct AlternativeIndex
+            {
+            };
+
+            template <typename T, typename... As>
+            struct AlternativeIndex<T, Enum<As...>> : FindAlternative<T, Enum<As...>>
+            {
+                static_assert(FindAlternative<T, Enum<As...>>::value < sizeof...(As),
+                              "token<T> needs T to be one of the alternatives of the token type");
+            };
+        }
+
+        // token: Matches a token of the given alternative
+        template <typename T>
+        struct TokenParser : ParserBase<TokenParser<T>>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, ElementOf<In>>
+            {
+                if (length(in) > 0 && matches(in))
+                    return tuple(drop(1, in), in[0]);
+                else
+                    return nothing;
+            }
+
+            size_t width() const
+            {
+                return 1;
+            }
+
+            // Compiles to an integer comparison of the alternative index
+            template <typename In>
+            bool matches(const In &in) const
+            {
+                return in[0].index() == detail::AlternativeIndex<T, ElementOf<In>>::value;
+            }
+
+            template <typename In>
+            ElementOf<In> output(const In &in) const
+            {
+                return in[0];
+            }
+        };
+
+        template <typename T>
+        struct IsFixedWidth<TokenParser<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        constexpr auto token() -> TokenParser<T>
+        {
+            return TokenParser<T>{};
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef EFP_UNICODE_PARSER_HPP_
+#define EFP_UNICODE_PARSER_HPP_
+
+#include <cstdint>
+
+#include "parser_base.hpp"
+#include "character_parser.hpp"
+
+// utf8_char: Decodes one UTF-8 code point as char32_t.
+// utf8_valid: Parses the longest valid UTF-8 prefix, 32 bytes at a time while the input is ASCII.
+// utf8_alpha0, utf8_alpha1, utf8_alphanumeric0, utf8_alphanumeric1, utf8_space0, utf8_space1:
+// UTF-8 aware versions of the character class runs. ASCII bytes take the same path as alpha1 and friends.
+// Alphabetic is the Unicode Alphabetic property, which includes the vowel signs of the Brahmic scripts, and
+// alphanumeric adds the decimal digits of the common scripts.
+// The input must expose contiguous data(), e.g. StringView or Cursor.
+// Invalid UTF-8 ends a run, and fails utf8_char.
+
+namespace efp
+{
+    namespace parser
+    {
+        namespace detail
+        {
+            inline bool is_continuation(unsigned char c)
+            {
+                return (c & 0xC0) == 0x80;
+            }
+
+            // Decodes a code point at p as in RFC 3629.
+            // Returns its length in bytes, or 0 if it is invalid, overlong, a surrogate or truncated.
+            inline size_t decode_utf8(const char *p, size_t size, char32_t &cp)
+            {
+                const auto b0 = static_cast<unsigned char>(p[0]);
+
+                if (b0 < 0x80)
+                {
+                    cp = b0;
+                    return 1;
+                }
+
+                size_t n;
+                char32_t min;
+                if ((b0 & 0xE0) == 0xC0)
+                {
+                    n = 2;
+                    min = 0x80;
+                    cp = b0 & 0x1F;
+                }
+                else if ((b0 & 0xF0) == 0xE0)
+                {
+                    n = 3;
+                    min = 0x800;
+                    cp = b0 & 0x0F;
+                }
+                else if ((b0 & 0xF8) == 0xF0)
+                {
+                    n = 4;
+                    min = 0x10000;
+                    cp = b0 & 0x07;
+                }
+                else
+                {
+                    return 0;
+                }
+
+                if (size < n)
+                    return 0;
+
+                for (size_t i = 1; i < n; ++i)
+                {
+                    const auto b = static_cast<unsigned char>(p[i]);
+                    if (!is_continuation(b))
+                        return 0;
+                    cp = (cp << 6) | (b & 0x3F);
+                }
+
+                if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+                    return 0;
+
+                return n;
+            }
+
+            // Length of the valid UTF-8 prefix, decoding one code point at a time
+            EFP_PARSER_DECL size_t utf8_valid_prefix_scalar(const char *p, size_t size);
+
+            // Start of the code point which may be cut at i, so that scalar decoding can resume from it
+            EFP_PARSER_DECL size_t utf8_resume_point(const char *p, size_t i);
+
+            // Length of the valid UTF-8 prefix, 32 bytes at a time while the input is ASCII
+            EFP_PARSER_DECL size_t utf8_valid_prefix(const char *p, size_t size);
+
+            // Letters of the common scripts outside ASCII
+            EFP_PARSER_DECL bool is_unicode_alpha(char32_t cp);
+
+            // Decimal digits of the common scripts outside ASCII
+            EFP_PARSER_DECL bool is_unicode_digit(char32_t cp);
+
+            // White_Space property outside ASCII
+            EFP_PARSER_DECL bool is_unicode_space(char32_t cp);
+
+            struct Utf8Alpha
+            {
+                static bool ascii(unsigned char c)
+                {
+                    return is_alpha(static_cast<char>(c));
+                }
+
+                static bool unicode(char32_t cp)
+                {
+                    return is_unicode_alpha(cp);
+                }
+            };
+
+            struct Utf8Alphanumeric
+            {
+                static bool ascii(unsigned char c)
+                {
+                    return is_alnum(static_cast<char>(c));
+                }
+
+                static bool unicode(char32_t cp)
+                {
+                    return is_unicode_alpha(cp) || is_unicode_digit(cp);
+                }
+            };
+
+            struct Utf8Space
+            {
+                static bool ascii(unsigned char c)
+                {
+                    return is_space(static_cast<char>(c));
+                }
+
+                static bool unicode(char32_t cp)
+                {
+                    return is_unicode_space(cp);
+                }
+            };
+        }
+
+        // utf8_char: Decodes one code point
+        struct Utf8CharParser : ParserBase<Utf8CharParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, char32_t>
+            {
+                char32_t cp;
+                const size_t n = length(in) > 0 ? detail::decode_utf8(in.data(), length(in), cp) : 0;
+
+                if (n > 0)
+                    return tuple(drop(n, in), cp);
+                else
+                    return nothing;
+            }
+        };
+
+        constexpr Utf8CharParser utf8_char{};
+
+        // utf8_valid: Parses the longest valid UTF-8 prefix
+        struct Utf8ValidParser : ParserBase<Utf8ValidParser>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, In>
+            {
+                const size_t n = detail::utf8_valid_prefix(in.data(), length(in));
+                return tuple(drop(n, in), take(n, in));
+            }
+        };
+
+        constexpr Utf8ValidParser utf8_valid{};
+
+        // Utf8ClassParser
+        // Run of code points of a class, at least min of them
+
+        template <typename Class, size_t min>
+        struct Utf8ClassParser : ParserBase<Utf8ClassParser<Class, min>>
+        {
+            template <typename In>
+            auto parse(const In &in) const -> Parsed<In, In>
+            {
+                const char *p = in.data();
+                const size_t size = length(in);
+
+                size_t i = 0;
+                size_t count = 0;
+                while (i < size)
+                {
+                    const auto c = static_cast<unsigned char>(p[i]);
+                    if (c < 0x80)
+                    {
+                        if (!Class::ascii(c))
+                            break;
+                        ++i;
+                    }
+                    else
+                    {
+                        char32_t cp;
+                        const size_t n = detail::decode_utf8(p + i, size - i, cp);
+                        if (n == 0 || !Class::unicode(cp))
+                            break;
+                        i += n;
+                    }
+                    ++count;
+                }
+
+                if (count >= min)
+                    return tuple(drop(i, in), take(i, in));
+                else
+                    return nothing;
+            }
+        };
+
+        constexpr Utf8ClassParser<detail::Utf8Alpha, 0> utf8_alpha0{};
+        constexpr Utf8ClassParser<detail::Utf8Alpha, 1> utf8_alpha1{};
+        constexpr Utf8ClassParser<detail::Utf8Alphanumeric, 0> utf8_alphanumeric0{};
+        constexpr Utf8ClassParser<detail::Utf8Alphanumeric, 1> utf8_alphanumeric1{};
+        constexpr Utf8ClassParser<detail::Utf8Space, 0> utf8_space0{};
+        constexpr Utf8ClassParser<detail::Utf8Space, 1> utf8_space1{};
+    }
+}
+
+#if !defined(EFP_PARSER_SEPARATE_COMPILATION)
+#include "impl/unicode_parser.ipp"
+#endif
+
+#endif
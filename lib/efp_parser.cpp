@@ -0,0 +1,8 @@
+// Compiled part of the efp_parser library, built with EFP_PARSER_SEPARATE_COMPILATION
+
+#include "parser.hpp"
+#include "json_parser.hpp"
+
+#include "impl/unicode_parser.ipp"
+#include "impl/escaped_string_parser.ipp"
+#include "impl/json_parser.ipp"
@@ -0,0 +1,68 @@
+#ifndef BATCH_TEST_HPP_
+#define BATCH_TEST_HPP_
+
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("parse_batch works correctly", "[parse_batch]")
+{
+    const std::vector<efp::StringView> inputs = {"cpu.load", "mem", "42", "disk.io", ""};
+    const auto metric = tpl(alpha1, skip(ch('.')), alpha1);
+
+    BatchResults<efp::StringView, CallParserO<decltype(metric), efp::StringView>> results(inputs.size());
+
+    SECTION("Results of each input")
+    {
+        const auto matched = parse_batch(metric, Span<efp::StringView>(inputs.data(), inputs.size()), results);
+
+        CHECK(matched == 2);
+        CHECK(results.size() == 5);
+
+        CHECK(results.matched(0));
+        CHECK(efp::p<0>(results.output(0)) == "cpu");
+        CHECK(efp::p<2>(results.output(0)) == "load");
+        CHECK(results.rest(0).empty());
+
+        CHECK_FALSE(results.matched(1));
+        CHECK_FALSE(results.matched(2));
+
+        CHECK(results.matched(3));
+        CHECK(efp::p<2>(results.output(3)) == "io");
+
+        CHECK_FALSE(results.matched(4));
+    }
+
+    SECTION("Same results with prefetching")
+    {
+        const auto matched = parse_batch<2>(metric, Span<efp::StringView>(inputs.data(), inputs.size()), results);
+
+        CHECK(matched == 2);
+        CHECK(results.matched(0));
+        CHECK(results.matched(3));
+        CHECK(efp::p<0>(results.output(3)) == "disk");
+    }
+
+    SECTION("Results grow to a batch of more inputs than the capacity")
+    {
+        std::vector<efp::StringView> more;
+        for (size_t i = 0; i < 4; ++i)
+            more.insert(more.end(), inputs.begin(), inputs.end());
+
+        const auto matched = parse_batch(metric, Span<efp::StringView>(more.data(), more.size()), results);
+
+        CHECK(matched == 8);
+        CHECK(results.size() == 20);
+        CHECK(results.capacity() >= 20);
+        CHECK(results.matched(18));
+        CHECK(efp::p<2>(results.output(18)) == "io");
+        CHECK_FALSE(results.matched(19));
+    }
+}
+
+#endif
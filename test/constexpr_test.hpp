@@ -0,0 +1,69 @@
+#ifndef CONSTEXPR_TEST_HPP_
+#define CONSTEXPR_TEST_HPP_
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+
+using namespace efp::parser;
+
+// Grammars evaluated at compile time over string literals
+
+constexpr auto key_value = tpl(alpha1, ch('='), parse_uint16, ch(';'));
+constexpr auto version = tpl(tag("v"), parse_uint8, ch('.'), parse_uint8, ch('.'), parse_uint8);
+constexpr auto method = alt(tag("GET"), tag("POST"), tag("PUT"));
+
+constexpr auto kv_res = key_value("port=8080;rest");
+static_assert(kv_res, "key_value matches");
+static_assert(efp::p<0>(snd(kv_res.value())) == "port", "");
+static_assert(efp::p<2>(snd(kv_res.value())) == 8080, "");
+static_assert(fst(kv_res.value()) == "rest", "");
+
+static_assert(!key_value("port=80800;"), "Out of range for uint16_t");
+static_assert(!key_value("port:8080;"), "");
+
+constexpr auto version_res = version("v1.22.3");
+static_assert(version_res, "");
+static_assert(efp::p<1>(snd(version_res.value())) == 1, "");
+static_assert(efp::p<3>(snd(version_res.value())) == 22, "");
+static_assert(efp::p<5>(snd(version_res.value())) == 3, "");
+
+static_assert(snd(method("POST /").value()) == "POST", "");
+static_assert(fst(method("PUT /").value()) == " /", "");
+static_assert(!method("DELETE /"), "");
+
+static_assert(snd(parse_int32("-2147483648").value()) == -2147483647 - 1, "");
+static_assert(!parse_int8("128"), "");
+static_assert(snd(parse_int8("-128").value()) == -128, "");
+static_assert(!parse_uint32("-1"), "");
+
+static_assert(snd(one_of("+-")("-1").value()) == '-', "");
+static_assert(!none_of("+-")("+1"), "");
+static_assert(snd(delimited(ch('['), hex_digit1, ch(']'))("[ff]").value()) == "ff", "");
+static_assert(fst(preceded(multispace0, digit1)(" \t42").value()).empty(), "");
+
+TEST_CASE("Parsers could be evaluated in constant expressions", "[constexpr]")
+{
+    SECTION("Compile time results match the runtime ones")
+    {
+        const auto res = key_value("port=8080;rest");
+        REQUIRE(res);
+        CHECK(efp::p<2>(snd(res.value())) == efp::p<2>(snd(kv_res.value())));
+        CHECK(fst(res.value()) == fst(kv_res.value()));
+    }
+
+    SECTION("Signs and overflow of the integer parsers")
+    {
+        const auto res = parse_int64("-9223372036854775808,");
+        REQUIRE(res);
+        CHECK(snd(res.value()) == INT64_MIN);
+        CHECK(fst(res.value()) == ",");
+
+        CHECK_FALSE(parse_int64("9223372036854775808"));
+        CHECK(snd(parse_uint64("18446744073709551615").value()) == UINT64_MAX);
+        CHECK_FALSE(parse_uint64("18446744073709551616"));
+        CHECK_FALSE(parse_int32("-"));
+    }
+}
+
+#endif
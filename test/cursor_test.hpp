@@ -0,0 +1,91 @@
+#ifndef CURSOR_TEST_HPP_
+#define CURSOR_TEST_HPP_
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("Cursor works correctly", "[cursor]")
+{
+    const Cursor in("hello world");
+
+    SECTION("Cursor covers the whole input")
+    {
+        CHECK(length(in) == 11);
+        CHECK(in.offset() == 0);
+        CHECK(in == "hello world");
+    }
+
+    SECTION("drop and take keep the offsets")
+    {
+        const auto rest = drop(6, in);
+        CHECK(rest == "world");
+        CHECK(rest.offset() == 6);
+
+        const auto head = take(5, in);
+        CHECK(head == "hello");
+        CHECK(head.offset() == 0);
+        CHECK(head.end_offset() == 5);
+    }
+}
+
+TEST_CASE("Parsers accept Cursor", "[cursor]")
+{
+    SECTION("Terminal parser")
+    {
+        auto result = alpha1(Cursor("abc123"));
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "123");
+            CHECK(fst(result.value()).offset() == 3);
+            CHECK(snd(result.value()) == "abc");
+        }
+    }
+
+    SECTION("Integer parser")
+    {
+        auto result = parse_int32(Cursor("42abc"));
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()).offset() == 2);
+            CHECK(snd(result.value()) == 42);
+        }
+    }
+
+    SECTION("Tuple parser")
+    {
+        auto result = tpl(ch('a'), tag("bc"), crlf, digit1)(Cursor("abc\r\n123rest"));
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "rest");
+            CHECK(fst(result.value()).offset() == 8);
+
+            auto res = snd(result.value());
+            CHECK(efp::p<0>(res) == 'a');
+            CHECK(efp::p<1>(res) == "bc");
+            CHECK(efp::p<3>(res) == "123");
+            CHECK(efp::p<3>(res).offset() == 5);
+        }
+    }
+
+    SECTION("Offset of the failure point")
+    {
+        const Cursor in("key = ?");
+        const auto key = terminated(alpha1, preceded(skip_space0, ch('=')))(in);
+        CHECK(key);
+        if (key)
+        {
+            const auto rest = fst(key.value());
+            CHECK_FALSE(preceded(skip_space0, alt(digit1, alpha1))(rest));
+            CHECK(rest.offset() == 5);
+        }
+    }
+}
+
+#endif
@@ -1,4 +1,20 @@
 #include "parser_test.hpp"
 #include "character_parser_test.hpp"
 #include "byte_parser_test.hpp"
-#include "parser_combinator_test.hpp"
\ No newline at end of file
+#include "parser_combinator_test.hpp"
+#include "cursor_test.hpp"
+#include "token_parser_test.hpp"
+#include "lexer_test.hpp"
+#include "batch_test.hpp"
+#include "fixed_format_parser_test.hpp"
+#include "unicode_parser_test.hpp"
+#include "escaped_string_parser_test.hpp"
+#include "json_parser_test.hpp"
+#include "constexpr_test.hpp"
+#include "rope_test.hpp"
+#include "thread_test.hpp"
+#include "parallel_test.hpp"
+#include "stream_test.hpp"
+#include "skim_test.hpp"
+#include "step_test.hpp"
+#include "partial_test.hpp"
\ No newline at end of file
@@ -0,0 +1,102 @@
+#ifndef ESCAPED_STRING_PARSER_TEST_HPP_
+#define ESCAPED_STRING_PARSER_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("escaped_string works correctly", "[escaped_string]")
+{
+    char buffer[64];
+
+    SECTION("Without escapes")
+    {
+        const efp::StringView in = "\"hello, world\": 1";
+        const auto res = escaped_string(in);
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == ": 1");
+
+        const auto s = efp::snd(res.value());
+        CHECK(s.raw == "hello, world");
+        CHECK_FALSE(s.has_escapes);
+        CHECK(s.value(buffer).data() == in.data() + 1);
+    }
+
+    SECTION("Long string")
+    {
+        const std::string contents(100, 'x');
+        const std::string in = "\"" + contents + "\"rest";
+        const auto res = escaped_string(efp::StringView(in.data(), in.size()));
+        CHECK(efp::fst(res.value()) == "rest");
+        CHECK(efp::snd(res.value()).raw.size() == 100);
+    }
+
+    SECTION("With escapes")
+    {
+        const auto res = escaped_string("\"a\\\"b\\\\c\\/d\\n\\t\" tail");
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == " tail");
+
+        const auto s = efp::snd(res.value());
+        CHECK(s.raw == "a\\\"b\\\\c\\/d\\n\\t");
+        CHECK(s.has_escapes);
+        CHECK(s.value(buffer) == "a\"b\\c/d\n\t");
+    }
+
+    SECTION("Unicode escapes")
+    {
+        const auto s = efp::snd(escaped_string("\"caf\\u00e9 \\u4E2D \\ud83d\\ude00\"").value());
+        CHECK(s.value(buffer) == "caf\xC3\xA9 \xE4\xB8\xAD \xF0\x9F\x98\x80");
+    }
+
+    SECTION("Escaped quote across the scanned blocks")
+    {
+        const std::string in = std::string(1, '"') + std::string(15, 'a') + "\\\"" + std::string(20, 'b') + "\"";
+        const auto s = efp::snd(escaped_string(efp::StringView(in.data(), in.size())).value());
+        const std::string expected = std::string(15, 'a') + "\"" + std::string(20, 'b');
+        CHECK(s.value(buffer) == efp::StringView(expected.data(), expected.size()));
+    }
+
+    SECTION("Invalid input")
+    {
+        CHECK_FALSE(escaped_string("hello"));
+        CHECK_FALSE(escaped_string("\"unterminated"));
+        CHECK_FALSE(escaped_string("\"trailing backslash\\"));
+        CHECK_FALSE(escaped_string("\"bad \\x escape\""));
+        CHECK_FALSE(escaped_string("\"bad \\u12G4\""));
+        CHECK_FALSE(escaped_string("\"lone \\udc00\""));
+        CHECK_FALSE(escaped_string("\"unpaired \\ud83d\""));
+    }
+
+    SECTION("Contents not matched by the parser are unescaped up to what is invalid")
+    {
+        const char *raws[] = {"ab\"cd\\n", "ab\\qcd", "ab\\u12", "ab\x01" "cd", "ab\\"};
+        for (const char *raw : raws)
+        {
+            const EscapedString s{efp::StringView(raw), true};
+            CHECK(s.value(buffer) == "ab");
+        }
+
+        const EscapedString escaped{efp::StringView("\\n\\\"x\""), true};
+        CHECK(escaped.value(buffer) == "\n\"x");
+    }
+
+    SECTION("Control characters must be escaped")
+    {
+        CHECK_FALSE(escaped_string("\"tab\there\""));
+        CHECK_FALSE(escaped_string("\"new\nline\""));
+        CHECK_FALSE(escaped_string("\"\x1F\""));
+        CHECK(escaped_string("\"\x20\x7F\xC3\xA9\""));
+
+        // Past the blocks scanned 16 bytes at a time
+        const std::string in = std::string(1, '"') + std::string(40, 'a') + "\x01" + "\"";
+        CHECK_FALSE(escaped_string(efp::StringView(in.data(), in.size())));
+    }
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef FIXED_FORMAT_PARSER_TEST_HPP_
+#define FIXED_FORMAT_PARSER_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+// Pseudo-random inputs for the comparisons with the vectorized paths
+inline std::string random_string(uint32_t &state, const char *alphabet, size_t alphabet_size, size_t size)
+{
+    std::string s;
+    for (size_t i = 0; i < size; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        s.push_back(alphabet[(state >> 16) % alphabet_size]);
+    }
+    return s;
+}
+
+// ipv4 of the address at the start of s, one byte at a time. Returns the length of the address, or 0 if invalid.
+inline size_t reference_ipv4(const std::string &s, uint32_t &value)
+{
+    size_t i = 0;
+    value = 0;
+    for (int k = 0; k < 4; ++k)
+    {
+        if (k > 0)
+        {
+            if (i == s.size() || s[i] != '.')
+                return 0;
+            ++i;
+        }
+
+        const size_t begin = i;
+        uint32_t octet = 0;
+        while (i < s.size() && s[i] >= '0' && s[i] <= '9' && i - begin < 4)
+            octet = octet * 10 + static_cast<uint32_t>(s[i++] - '0');
+
+        const size_t n = i - begin;
+        if (n == 0 || n > 3 || octet > 255 || (n > 1 && s[begin] == '0'))
+            return 0;
+        value = (value << 8) | octet;
+    }
+
+    // The address must not go on with a digit or a dot
+    if (i < s.size() && ((s[i] >= '0' && s[i] <= '9') || s[i] == '.'))
+        return 0;
+    return i;
+}
+
+TEST_CASE("fixed_uint works correctly", "[fixed_uint]")
+{
+    SECTION("Up to 8 digits")
+    {
+        const auto res = fixed_uint<4>()("2024-10");
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == "-10");
+        CHECK(efp::snd(res.value()) == 2024);
+
+        CHECK(efp::snd(fixed_uint<8>()("00123456").value()) == 123456);
+        CHECK(efp::snd(fixed_uint<1>()("7").value()) == 7);
+    }
+
+    SECTION("More than 8 digits")
+    {
+        const auto res = fixed_uint<12>()("123456789012abc");
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == "abc");
+        CHECK(efp::snd(res.value()) == 123456789012ull);
+    }
+
+    SECTION("Invalid input")
+    {
+        CHECK_FALSE(fixed_uint<4>()("123"));
+        CHECK_FALSE(fixed_uint<4>()("12a4"));
+        CHECK_FALSE(fixed_uint<4>()("12:4"));
+        CHECK_FALSE(fixed_uint<10>()("12345/7890"));
+    }
+}
+
+TEST_CASE("date_time works correctly", "[date_time]")
+{
+    SECTION("Valid date time")
+    {
+        const auto res = date_time("2024-02-29T23:59:60Z");
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == "Z");
+
+        const auto value = efp::snd(res.value());
+        CHECK(value.year == 2024);
+        CHECK(value.month == 2);
+        CHECK(value.day == 29);
+        CHECK(value.hour == 23);
+        CHECK(value.minute == 59);
+        CHECK(value.second == 60);
+    }
+
+    SECTION("Invalid format")
+    {
+        CHECK_FALSE(date_time("2024-02-29 23:59:59"));
+        CHECK_FALSE(date_time("2024-02-29T23:59-59"));
+        CHECK_FALSE(date_time("2024-0a-29T23:59:59"));
+        CHECK_FALSE(date_time("2024-02-29T23:59:5x"));
+        CHECK_FALSE(date_time("2024-02-29T23:59"));
+    }
+
+    SECTION("Out of range fields")
+    {
+        CHECK_FALSE(date_time("2024-13-01T00:00:00"));
+        CHECK_FALSE(date_time("2024-00-01T00:00:00"));
+        CHECK_FALSE(date_time("2024-01-32T00:00:00"));
+        CHECK_FALSE(date_time("2024-01-01T24:00:00"));
+        CHECK_FALSE(date_time("2024-01-01T00:60:00"));
+    }
+}
+
+TEST_CASE("date_time matches its fields parsed one at a time", "[date_time]")
+{
+    // On an SSSE3 build, date_time gathers the digits in a vector, and this compares it with the scalar fields
+    const auto fields = tpl(fixed_uint<4>(), ch('-'), fixed_uint<2>(), ch('-'), fixed_uint<2>(), ch('T'),
+                            fixed_uint<2>(), ch(':'), fixed_uint<2>(), ch(':'), fixed_uint<2>());
+    const char alphabet[] = "0123456789-T:0123456789 x";
+    uint32_t state = 2024;
+
+    for (int n = 0; n < 20000; ++n)
+    {
+        // A valid date time with a few of its bytes replaced
+        std::string in = "2024-02-29T23:59:60" + random_string(state, alphabet, sizeof(alphabet) - 1, n % 4);
+        for (int k = 0; k < n % 4; ++k)
+        {
+            state = state * 1103515245 + 12345;
+            in[(state >> 16) % 19] = alphabet[(state >> 8) % (sizeof(alphabet) - 1)];
+        }
+
+        const auto res = date_time(efp::StringView(in.data(), in.size()));
+        const auto ref = fields(efp::StringView(in.data(), in.size()));
+
+        const bool in_range = ref && efp::p<2>(efp::snd(ref.value())) >= 1 && efp::p<2>(efp::snd(ref.value())) <= 12 &&
+                              efp::p<4>(efp::snd(ref.value())) >= 1 && efp::p<4>(efp::snd(ref.value())) <= 31 &&
+                              efp::p<6>(efp::snd(ref.value())) <= 23 && efp::p<8>(efp::snd(ref.value())) <= 59 &&
+                              efp::p<10>(efp::snd(ref.value())) <= 60;
+
+        REQUIRE(static_cast<bool>(res) == in_range);
+        if (res)
+        {
+            const auto value = efp::snd(res.value());
+            CHECK(value.year == efp::p<0>(efp::snd(ref.value())));
+            CHECK(value.month == efp::p<2>(efp::snd(ref.value())));
+            CHECK(value.day == efp::p<4>(efp::snd(ref.value())));
+            CHECK(value.hour == efp::p<6>(efp::snd(ref.value())));
+            CHECK(value.minute == efp::p<8>(efp::snd(ref.value())));
+            CHECK(value.second == efp::p<10>(efp::snd(ref.value())));
+        }
+    }
+}
+
+TEST_CASE("ipv4 works correctly", "[ipv4]")
+{
+    SECTION("Valid addresses")
+    {
+        const auto res = ipv4("192.168.0.1");
+        CHECK(res);
+        CHECK(efp::fst(res.value()) == "");
+        CHECK(efp::snd(res.value()) == 0xC0A80001);
+
+        const auto res_long = ipv4("255.255.255.255:8080 and more");
+        CHECK(res_long);
+        CHECK(efp::fst(res_long.value()) == ":8080 and more");
+        CHECK(efp::snd(res_long.value()) == 0xFFFFFFFF);
+
+        CHECK(efp::snd(ipv4("0.0.0.0").value()) == 0);
+        CHECK(efp::snd(ipv4("255.255.255.255").value()) == 0xFFFFFFFF);
+        CHECK(efp::fst(ipv4("10.0.0.12ab").value()) == "ab");
+    }
+
+    SECTION("Invalid addresses")
+    {
+        CHECK_FALSE(ipv4("256.1.1.1"));
+        CHECK_FALSE(ipv4("1.2.3"));
+        CHECK_FALSE(ipv4("1.2.3.4.5"));
+        CHECK_FALSE(ipv4("01.2.3.4"));
+        CHECK_FALSE(ipv4("1..3.4"));
+        CHECK_FALSE(ipv4(".1.2.3"));
+        CHECK_FALSE(ipv4("..."));
+        CHECK_FALSE(ipv4(".1.2.3.4"));
+        CHECK_FALSE(ipv4("1.2.3."));
+        CHECK_FALSE(ipv4("1234.2.3.4"));
+        CHECK_FALSE(ipv4("a.b.c.d"));
+        CHECK_FALSE(ipv4("255.255.255.2555"));
+    }
+
+    SECTION("Matches the address parsed one byte at a time")
+    {
+        // On an SSSE3 build, ipv4 classifies 16 bytes at once, and this compares it with the scalar reference
+        const char digits[] = "0123456789";
+        const char tails[] = ".5x";
+        uint32_t state = 4;
+
+        for (int n = 0; n < 20000; ++n)
+        {
+            // Octets of 0 to 4 digits, mostly of 1 to 3, and a tail which may go on with the address
+            std::string in;
+            for (int k = 0; k < 4; ++k)
+            {
+                state = state * 1103515245 + 12345;
+                const size_t octet_length = 1 + (state >> 16) % 3 - ((state >> 24) % 16 == 0) + ((state >> 24) % 16 == 1);
+                in += random_string(state, digits, 10, octet_length) + (k < 3 ? "." : "");
+            }
+            in += random_string(state, tails, 3, n % 3);
+
+            uint32_t expected;
+            const size_t expected_length = reference_ipv4(in, expected);
+            const auto res = ipv4(efp::StringView(in.data(), in.size()));
+
+            REQUIRE(static_cast<bool>(res) == (expected_length > 0));
+            if (res)
+            {
+                CHECK(efp::snd(res.value()) == expected);
+                CHECK(efp::fst(res.value()).size() == in.size() - expected_length);
+            }
+        }
+    }
+}
+
+#endif
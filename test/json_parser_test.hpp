@@ -0,0 +1,142 @@
+#ifndef JSON_PARSER_TEST_HPP_
+#define JSON_PARSER_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "json_parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+// Records the events as text
+struct JsonEventLog
+{
+    std::string log;
+
+    void null() { log += "null "; }
+    void boolean(bool b) { log += b ? "true " : "false "; }
+    void number(double n) { log += std::to_string(static_cast<long long>(n)) + " "; }
+    void string(const EscapedString &s) { log += '"' + std::string(s.raw.data(), s.raw.size()) + "\" "; }
+    void key(const EscapedString &s) { log += std::string(s.raw.data(), s.raw.size()) + ": "; }
+    void start_object() { log += "{ "; }
+    void end_object() { log += "} "; }
+    void start_array() { log += "[ "; }
+    void end_array() { log += "] "; }
+};
+
+TEST_CASE("json_number works correctly", "[json_number]")
+{
+    CHECK(efp::snd(json_number("0").value()) == 0.);
+    CHECK(efp::snd(json_number("-12").value()) == -12.);
+    CHECK(efp::snd(json_number("3.25").value()) == 3.25);
+    CHECK(efp::snd(json_number("1e3").value()) == 1000.);
+    CHECK(efp::snd(json_number("-2.5E-2").value()) == -0.025);
+    CHECK(efp::snd(json_number("0.000123").value()) == 0.000123);
+    CHECK(efp::snd(json_number("1.7976931348623157e308").value()) == 1.7976931348623157e308);
+    CHECK(efp::snd(json_number("12345678901234567890123").value()) == 12345678901234567890123.);
+
+    const auto res = json_number("01");
+    CHECK(efp::fst(res.value()) == "1");
+
+    CHECK_FALSE(json_number("-"));
+    CHECK_FALSE(json_number("1."));
+    CHECK_FALSE(json_number("1e"));
+    CHECK_FALSE(json_number(".5"));
+    CHECK_FALSE(json_number("+1"));
+}
+
+TEST_CASE("json_sax works correctly", "[json_sax]")
+{
+    SECTION("Events of a document")
+    {
+        JsonEventLog handler;
+        CHECK(json_sax(" {\"a\": [1, true, null], \"b\" : {\"c\":\"d\"}, \"e\":[ ] } ", handler));
+        CHECK(handler.log == "{ a: [ 1 true null ] b: { c: \"d\" } e: [ ] } ");
+    }
+
+    SECTION("Scalars as documents")
+    {
+        JsonEventLog handler;
+        CHECK(json_sax("false", handler));
+        CHECK(json_sax("\"s\"", handler));
+        CHECK(handler.log == "false \"s\" ");
+    }
+
+    SECTION("Invalid documents")
+    {
+        JsonEventLog handler;
+        CHECK_FALSE(json_sax("", handler));
+        CHECK_FALSE(json_sax("[1, 2,]", handler));
+        CHECK_FALSE(json_sax("{\"a\" 1}", handler));
+        CHECK_FALSE(json_sax("{\"a\": 1,}", handler));
+        CHECK_FALSE(json_sax("[1] 2", handler));
+        CHECK_FALSE(json_sax("tru", handler));
+        CHECK_FALSE(json_sax("{1: 2}", handler));
+    }
+
+    SECTION("Raw control characters in strings")
+    {
+        JsonEventLog handler;
+        CHECK_FALSE(json_sax("[\"a\tb\"]", handler));
+        CHECK_FALSE(json_sax("{\"a\nb\": 1}", handler));
+        CHECK(json_sax("[\"a\\tb\"]", handler));
+    }
+
+    SECTION("Nesting beyond the maximum depth")
+    {
+        JsonEventLog handler;
+        const auto nested = [&](size_t depth, size_t max_depth)
+        {
+            const std::string in = std::string(depth, '[') + "1" + std::string(depth, ']');
+            return json_sax(efp::StringView(in.data(), in.size()), handler, max_depth);
+        };
+
+        CHECK(nested(json_max_depth, json_max_depth));
+        CHECK_FALSE(nested(json_max_depth + 1, json_max_depth));
+        CHECK(nested(3, 3));
+        CHECK_FALSE(json_sax("{\"a\": {\"b\": [1]}}", handler, 2));
+
+        // Would exhaust the stack without the limit
+        const std::string deep = std::string(1 << 20, '[');
+        CHECK_FALSE(json_sax(efp::StringView(deep.data(), deep.size()), handler));
+
+        JsonArena arena;
+        CHECK_FALSE(json_dom(efp::StringView(deep.data(), deep.size()), arena));
+    }
+}
+
+TEST_CASE("json_dom works correctly", "[json_dom]")
+{
+    JsonArena arena(64);
+
+    const auto res = json_dom("{\"name\": \"caf\\u00e9\", \"values\": [1.5, -2, {\"deep\": [[]]}], \"ok\": true, \"none\": null}", arena);
+    CHECK(res);
+
+    const auto root = res.value();
+    CHECK(root.type == JsonType::Object);
+    CHECK(root.size == 4);
+
+    const auto name = root.find("name");
+    CHECK(name != nullptr);
+    CHECK(name->type == JsonType::String);
+    CHECK(name->string == "caf\xC3\xA9");
+
+    const auto values = root.find("values");
+    CHECK(values->type == JsonType::Array);
+    CHECK(values->size == 3);
+    CHECK((*values)[0].number == 1.5);
+    CHECK((*values)[1].number == -2.);
+    CHECK((*values)[2].find("deep")->type == JsonType::Array);
+    CHECK((*values)[2].find("deep")->size == 1);
+    CHECK((*(*values)[2].find("deep"))[0].size == 0);
+
+    CHECK(root.find("ok")->boolean);
+    CHECK(root.find("none")->type == JsonType::Null);
+    CHECK(root.find("missing") == nullptr);
+
+    CHECK_FALSE(json_dom("[1, 2", arena));
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef LEXER_TEST_HPP_
+#define LEXER_TEST_HPP_
+
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("lexer works correctly", "[lexer]")
+{
+    enum Kind
+    {
+        If,
+        Identifier,
+        Number,
+        Operator,
+        Whitespace,
+    };
+
+    const auto lex = lexer(tag("if"), tpl(alpha1, alphanumeric0), digit1, one_of("+-*/=()"), multispace1);
+
+    SECTION("Keyword wins the tie by the order of definition")
+    {
+        auto result = lex("if x");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == " x");
+            CHECK(snd(result.value()).kind == If);
+            CHECK(snd(result.value()).text == "if");
+        }
+    }
+
+    SECTION("Longest match wins")
+    {
+        auto result = lex("iffy = 1");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == " = 1");
+            CHECK(snd(result.value()).kind == Identifier);
+            CHECK(snd(result.value()).text == "iffy");
+        }
+    }
+
+    SECTION("Same character classes as the parsers, whatever the locale")
+    {
+        // Latin-1 bytes, and \v and \f which are spaces to multispace1
+        const char *inputs[] = {"\xE9t\xE9", "ab\xC0", "\x85", "\xA0x", "\v\f1", "\xB2"};
+        const auto classes = lexer(alpha1, alphanumeric1, digit1, hex_digit1, multispace1, space1);
+        const auto parsers = alt(alpha1, alphanumeric1, digit1, hex_digit1, multispace1, space1);
+
+        for (const char *in : inputs)
+        {
+            const auto res = classes(in);
+            const auto expected = parsers(in);
+
+            REQUIRE(static_cast<bool>(res) == static_cast<bool>(expected));
+            if (res)
+                CHECK(snd(res.value()).text == snd(expected.value()));
+        }
+    }
+
+    SECTION("No token matches")
+    {
+        CHECK_FALSE(lex("$x"));
+        CHECK_FALSE(lex(""));
+    }
+
+    SECTION("Tokenize in a single pass")
+    {
+        std::vector<Lexeme<efp::StringView>> tokens;
+        const auto rest = lex.tokenize(efp::StringView("x1 = (42+y)"), tokens);
+
+        CHECK(rest.empty());
+        REQUIRE(tokens.size() == 9);
+        CHECK(tokens[0].kind == Identifier);
+        CHECK(tokens[0].text == "x1");
+        CHECK(tokens[1].kind == Whitespace);
+        CHECK(tokens[2].kind == Operator);
+        CHECK(tokens[5].kind == Number);
+        CHECK(tokens[5].text == "42");
+        CHECK(tokens[7].kind == Identifier);
+    }
+
+    SECTION("Tokenize stops where no token matches")
+    {
+        std::vector<Lexeme<efp::StringView>> tokens;
+        const auto rest = lex.tokenize(efp::StringView("x $"), tokens);
+
+        CHECK(rest == "$");
+        CHECK(tokens.size() == 2);
+    }
+}
+
+TEST_CASE("lexer DFA is minimized", "[lexer]")
+{
+    // Start, after 'a' or 'c', after "ab" or "cb", and the dead state
+    const auto lex = lexer(alt(tag("ab"), tag("cb")));
+    CHECK(lex.state_count() == 4);
+}
+
+TEST_CASE("token stream is parsed by lexeme", "[lexer][lexeme]")
+{
+    const auto lex = lexer(alpha1, ch('='), digit1, skip_space1);
+
+    std::vector<Lexeme<efp::StringView>> tokens;
+    lex.tokenize(efp::StringView("x=1"), tokens);
+
+    const auto result = tpl(lexeme(0), lexeme(1), lexeme(2))(Span<Lexeme<efp::StringView>>(tokens.data(), tokens.size()));
+    CHECK(result);
+    if (result)
+    {
+        CHECK(efp::p<0>(snd(result.value())).text == "x");
+        CHECK(efp::p<2>(snd(result.value())).text == "1");
+    }
+}
+
+#endif
@@ -0,0 +1,36 @@
+// Second translation unit of the tests. Every header is included again here, so the test binary only links if
+// the headers define nothing twice.
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+#include "json_parser.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("Parsers could be used from more than one translation unit", "[odr]")
+{
+    SECTION("Terminals")
+    {
+        CHECK(alpha1("abc1"));
+        CHECK(tag("GET")("GET /"));
+        CHECK(one_of("+-")("-1"));
+        CHECK(parse_int32("42"));
+    }
+
+    SECTION("Compiled functions")
+    {
+        CHECK(utf8_valid("caf\xC3\xA9"));
+        CHECK(utf8_alpha1("\xC3\xA9t\xC3\xA9"));
+
+        const auto res = escaped_string("\"a\\nb\"");
+        REQUIRE(res);
+        char buffer[8];
+        CHECK(snd(res.value()).value(buffer) == efp::StringView("a\nb"));
+
+        JsonArena arena;
+        CHECK(json_dom("[1, \"two\", {\"three\": null}]", arena));
+    }
+}
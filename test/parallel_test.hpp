@@ -0,0 +1,164 @@
+#ifndef PARALLEL_TEST_HPP_
+#define PARALLEL_TEST_HPP_
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("parallel_separated works correctly", "[parallel_separated]")
+{
+    // Lines of key=value, located by a scan to the line ending
+    const auto record = tpl(alpha1, ch('='), parse_uint32);
+
+    std::string lines;
+    for (size_t i = 0; i < 1000; ++i)
+        lines += "key" + std::string(1, static_cast<char>('a' + i % 26)) + "=" + std::to_string(i) + "\n";
+    lines += "trailing";
+
+    const efp::StringView in(lines.data(), lines.size());
+    const efp::StringView tail(lines.data() + lines.size() - 9, 9);
+
+    SECTION("Outputs in order, on a single thread")
+    {
+        const auto res = parallel_separated(line_ending, not_line_ending, record, 1)(in);
+
+        REQUIRE(res);
+        CHECK(fst(res.value()) == tail);
+        REQUIRE(snd(res.value()).size() == 1000);
+        CHECK(efp::p<0>(snd(res.value())[0]) == "keya");
+        CHECK(efp::p<2>(snd(res.value())[999]) == 999);
+    }
+
+    SECTION("Same outputs on several threads")
+    {
+        const auto res = parallel_separated(line_ending, not_line_ending, record, 4, 0)(in);
+
+        REQUIRE(res);
+        CHECK(fst(res.value()) == tail);
+        REQUIRE(snd(res.value()).size() == 1000);
+        for (size_t i = 0; i < 1000; ++i)
+            CHECK(efp::p<2>(snd(res.value())[i]) == i);
+    }
+
+    SECTION("List ends before the first element not matched as a whole")
+    {
+        std::string broken = lines;
+        broken.replace(broken.find("=501\n"), 4, "=5x1");
+
+        const auto res = parallel_separated(line_ending, not_line_ending, record, 4, 0)(
+            efp::StringView(broken.data(), broken.size()));
+
+        REQUIRE(res);
+        REQUIRE(snd(res.value()).size() == 501);
+        CHECK(efp::p<2>(snd(res.value())[500]) == 500);
+        CHECK(start_with(fst(res.value()), efp::StringView("\nkeyh=5x1")));
+    }
+
+    SECTION("Same list with and without threads, on an element matched in part")
+    {
+        std::string broken = lines;
+        broken.replace(broken.find("=501\n"), 4, "=50x");
+        const efp::StringView broken_in(broken.data(), broken.size());
+
+        const auto serial = parallel_separated(line_ending, not_line_ending, record, 1)(broken_in);
+        const auto short_input = parallel_separated(line_ending, not_line_ending, record, 4)(broken_in);
+        const auto parallel = parallel_separated(line_ending, not_line_ending, record, 4, 0)(broken_in);
+
+        REQUIRE(serial);
+        REQUIRE(short_input);
+        REQUIRE(parallel);
+        CHECK(snd(serial.value()).size() == 501);
+        CHECK(snd(short_input.value()).size() == 501);
+        CHECK(snd(parallel.value()).size() == 501);
+        CHECK(fst(serial.value()) == fst(parallel.value()));
+        CHECK(fst(short_input.value()) == fst(parallel.value()));
+        CHECK(start_with(fst(serial.value()), efp::StringView("\nkeyh=50x")));
+    }
+
+    SECTION("Outputs of bool are written by several threads at once")
+    {
+        const auto even = map(record, [](const efp::Tuple<efp::StringView, char, uint32_t> &r)
+                              { return efp::p<2>(r) % 2 == 0; });
+        const auto res = parallel_separated(line_ending, not_line_ending, even, 4, 0)(in);
+
+        REQUIRE(res);
+        CHECK(fst(res.value()) == tail);
+        REQUIRE(snd(res.value()).size() == 1000);
+        for (size_t i = 0; i < 1000; ++i)
+            CHECK(snd(res.value())[i] == (i % 2 == 0));
+    }
+
+    SECTION("An exception thrown on a worker reaches the caller")
+    {
+        const auto throwing = map(record, [](const efp::Tuple<efp::StringView, char, uint32_t> &r)
+                                  {
+                                      if (efp::p<2>(r) == 700)
+                                          throw std::runtime_error("700");
+                                      return efp::p<2>(r); });
+
+        CHECK_THROWS_AS(parallel_separated(line_ending, not_line_ending, throwing, 4, 0)(in), std::runtime_error);
+        CHECK_THROWS_AS(parallel_separated(line_ending, not_line_ending, throwing, 1)(in), std::runtime_error);
+    }
+
+    SECTION("An exception past a failed element is not thrown, with or without threads")
+    {
+        const auto throwing = map(record, [](const efp::Tuple<efp::StringView, char, uint32_t> &r)
+                                  {
+                                      if (efp::p<2>(r) == 700)
+                                          throw std::runtime_error("700");
+                                      return efp::p<2>(r); });
+
+        std::string broken = lines;
+        broken.replace(broken.find("=301\n"), 4, "=30x");
+        const efp::StringView broken_in(broken.data(), broken.size());
+
+        const auto serial = parallel_separated(line_ending, not_line_ending, throwing, 1)(broken_in);
+        const auto parallel = parallel_separated(line_ending, not_line_ending, throwing, 4, 0)(broken_in);
+
+        REQUIRE(serial);
+        REQUIRE(parallel);
+        CHECK(snd(serial.value()).size() == 301);
+        CHECK(snd(parallel.value()).size() == 301);
+        CHECK(fst(serial.value()) == fst(parallel.value()));
+    }
+
+    SECTION("Separators and elements consuming nothing end the list")
+    {
+        const auto list = parallel_separated(space0, alpha0, alpha0, 4, 0);
+        const auto serial = parallel_separated(space0, alpha0, alpha0, 1);
+
+        for (const char *input : {"", "1", "ab cd1"})
+        {
+            const auto res = list(efp::StringView(input));
+            const auto serial_res = serial(efp::StringView(input));
+
+            REQUIRE(res);
+            REQUIRE(serial_res);
+            CHECK(fst(res.value()) == fst(serial_res.value()));
+            CHECK(snd(res.value()).size() == snd(serial_res.value()).size());
+        }
+
+        const auto res = list("ab cd1");
+        REQUIRE(res);
+        CHECK(fst(res.value()) == "1");
+        CHECK(snd(res.value()).size() == 2);
+    }
+
+    SECTION("Zero elements")
+    {
+        const auto res = parallel_separated(line_ending, alpha1, record, 4, 0)("123");
+
+        REQUIRE(res);
+        CHECK(fst(res.value()) == "123");
+        CHECK(snd(res.value()).empty());
+    }
+}
+
+#endif
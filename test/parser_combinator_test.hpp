@@ -1,6 +1,9 @@
 #ifndef PARSER_COMBINATOR_TEST_HPP_
 #define PARSER_COMBINATOR_TEST_HPP_
 
+#include <stdexcept>
+#include <string>
+
 #include "catch2/catch_test_macros.hpp"
 
 #include "parser.hpp"
@@ -128,4 +131,509 @@ TEST_CASE("tuple parser combinator works correctly", "[tpl]")
     }
 }
 
+TEST_CASE("tuple parser fuses fixed width parsers", "[tpl]")
+{
+    auto tpl_parser = tpl(ch('a'), tag("bc"), crlf, digit1, tab, ch(':'));
+
+    SECTION("All parsers match in sequence")
+    {
+        auto result = tpl_parser("abc\r\n123\t:rest");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "rest");
+            auto res = snd(result.value());
+            CHECK(efp::p<0>(res) == 'a');
+            CHECK(efp::p<1>(res) == "bc");
+            CHECK(efp::p<2>(res) == "\r\n");
+            CHECK(efp::p<3>(res) == "123");
+            CHECK(efp::p<4>(res) == '\t');
+            CHECK(efp::p<5>(res) == ':');
+        }
+    }
+
+    SECTION("Fused parser fails in the middle of the run")
+    {
+        auto result = tpl_parser("abd\r\n123\t:");
+        CHECK_FALSE(result);
+    }
+
+    SECTION("Input shorter than the run")
+    {
+        auto result = tpl_parser("abc\r");
+        CHECK_FALSE(result);
+    }
+
+    SECTION("Fused run at the end fails")
+    {
+        auto result = tpl_parser("abc\r\n123\t;");
+        CHECK_FALSE(result);
+    }
+}
+
+std::string to_string(const efp::StringView &s)
+{
+    return std::string(s.data(), length(s));
+}
+
+TEST_CASE("tuple parser with owning outputs and several runs", "[tpl]")
+{
+    auto tpl_parser = tpl(map(alpha1, to_string), ch('='), ch('['), digit1, ch(']'),
+                          map(alphanumeric1, to_string), tab, newline, ch('.'));
+
+    SECTION("All parsers match in sequence")
+    {
+        auto result = tpl_parser("key=[42]v4l\t\n.");
+        REQUIRE(result);
+        CHECK(length(fst(result.value())) == 0);
+        auto res = snd(result.value());
+        CHECK(efp::p<0>(res) == "key");
+        CHECK(efp::p<3>(res) == "42");
+        CHECK(efp::p<5>(res) == "v4l");
+        CHECK(efp::p<8>(res) == '.');
+    }
+
+    SECTION("Outputs already built are released on failure")
+    {
+        CHECK_FALSE(tpl_parser("key=[42]v4l\t\n,"));
+        CHECK_FALSE(tpl_parser("key=[42;"));
+        CHECK_FALSE(tpl_parser("key=(42]"));
+    }
+}
+
+TEST_CASE("skip parser works correctly", "[skip]")
+{
+    SECTION("Skips the output")
+    {
+        auto result = skip(digit1)("123abc");
+        CHECK(result);
+        if (result)
+            CHECK(fst(result.value()) == "abc");
+    }
+
+    SECTION("Fails if the parser fails")
+    {
+        auto result = skip(digit1)("abc");
+        CHECK_FALSE(result);
+    }
+}
+
+TEST_CASE("preceded, terminated and delimited work correctly", "[preceded][terminated][delimited]")
+{
+    SECTION("preceded returns the second output")
+    {
+        auto result = preceded(skip_space0, digit1)("  123abc");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "abc");
+            CHECK(snd(result.value()) == "123");
+        }
+    }
+
+    SECTION("terminated returns the first output")
+    {
+        auto result = terminated(alpha1, ch(';'))("abc;123");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "123");
+            CHECK(snd(result.value()) == "abc");
+        }
+    }
+
+    SECTION("delimited returns the middle output")
+    {
+        auto result = delimited(ch('('), digit1, ch(')'))("(42)rest");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "rest");
+            CHECK(snd(result.value()) == "42");
+        }
+    }
+
+    SECTION("Any failing parser fails the whole")
+    {
+        CHECK_FALSE(preceded(ch('a'), digit1)("b123"));
+        CHECK_FALSE(terminated(alpha1, ch(';'))("abc,"));
+        CHECK_FALSE(delimited(ch('('), digit1, ch(')'))("(42"));
+    }
+
+    SECTION("Whitespace skipping inside of tuple parser")
+    {
+        auto result = tpl(alpha1, skip_multispace1, digit1)("abc \t\n123");
+        CHECK(result);
+        if (result)
+        {
+            auto res = snd(result.value());
+            CHECK(efp::p<0>(res) == "abc");
+            CHECK(efp::p<2>(res) == "123");
+        }
+    }
+}
+
+TEST_CASE("separated0 works correctly", "[separated0]")
+{
+    SECTION("Counts the elements")
+    {
+        auto result = separated0(ch(','), digit1)("1,22,333;");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == ";");
+            CHECK(snd(result.value()) == 3);
+        }
+    }
+
+    SECTION("Zero elements")
+    {
+        auto result = separated0(ch(','), digit1)("abc");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "abc");
+            CHECK(snd(result.value()) == 0);
+        }
+    }
+
+    SECTION("Trailing separator is not consumed")
+    {
+        auto result = separated0(ch(','), digit1)("1,2,]");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == ",]");
+            CHECK(snd(result.value()) == 2);
+        }
+    }
+
+    SECTION("Stops when a separator and an element consume nothing")
+    {
+        const auto list = separated0(space0, alpha0);
+
+        auto empty = list("");
+        CHECK(empty);
+        if (empty)
+        {
+            CHECK(fst(empty.value()) == "");
+            CHECK(snd(empty.value()) == 1);
+        }
+
+        auto digit = list("1");
+        CHECK(digit);
+        if (digit)
+        {
+            CHECK(fst(digit.value()) == "1");
+            CHECK(snd(digit.value()) == 1);
+        }
+
+        const auto skimmed = skim(list, "ab cd1");
+        CHECK(skimmed);
+        if (skimmed)
+            CHECK(skimmed.value() == "1");
+    }
+}
+
+int to_int(const efp::StringView &s)
+{
+    int n = 0;
+    for (size_t i = 0; i < length(s); ++i)
+        n = n * 10 + (s[i] - '0');
+    return n;
+}
+
+efp::Maybe<int> small_int(const efp::StringView &s)
+{
+    if (length(s) <= 2)
+        return to_int(s);
+    else
+        return efp::nothing;
+}
+
+bool is_even(const efp::StringView &s)
+{
+    return (s[length(s) - 1] - '0') % 2 == 0;
+}
+
+TEST_CASE("map, map_res, value and verify work correctly", "[map][map_res][value][verify]")
+{
+    SECTION("map converts the output")
+    {
+        auto result = map(digit1, to_int)("123abc");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == "abc");
+            CHECK(snd(result.value()) == 123);
+        }
+
+        auto lambda = map(tpl(digit1, ch('.'), digit1), [](const efp::Tuple<efp::StringView, char, efp::StringView> &t)
+                          { return to_int(efp::p<0>(t)) * 100 + to_int(efp::p<2>(t)); });
+        CHECK(snd(lambda("3.14").value()) == 314);
+
+        CHECK_FALSE(map(digit1, to_int)("abc"));
+    }
+
+    SECTION("map_res fails when the function fails")
+    {
+        auto result = map_res(digit1, small_int)("42;");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == ";");
+            CHECK(snd(result.value()) == 42);
+        }
+
+        CHECK_FALSE(map_res(digit1, small_int)("420;"));
+        CHECK_FALSE(map_res(digit1, small_int)(";"));
+    }
+
+    SECTION("value replaces the output")
+    {
+        auto result = value(tag("true"), true)("true,");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(fst(result.value()) == ",");
+            CHECK(snd(result.value()) == true);
+        }
+
+        CHECK_FALSE(value(tag("true"), true)("false"));
+    }
+
+    SECTION("verify checks the output")
+    {
+        auto result = verify(digit1, is_even)("124x");
+        CHECK(result);
+        if (result)
+        {
+            CHECK(snd(result.value()) == "124");
+        }
+
+        CHECK_FALSE(verify(digit1, is_even)("123x"));
+    }
+}
+
+struct PairTag {};
+struct ListTag {};
+
+// Records the events as text
+struct EventLog
+{
+    std::string log;
+
+    void value(const efp::StringView &s) { log += std::string(s.data(), s.size()) + " "; }
+    void value(char c) { log += std::string(1, c) + " "; }
+    void start(PairTag) { log += "<pair "; }
+    void end(PairTag) { log += "pair> "; }
+    void start(ListTag) { log += "<list "; }
+    void end(ListTag) { log += "list> "; }
+};
+
+TEST_CASE("parse_events works correctly", "[parse_events][event]")
+{
+    SECTION("Tuple reports each output in turn")
+    {
+        EventLog sink;
+        const auto res = parse_events(tpl(alpha1, ch('='), digit1), "abc=123;", sink);
+        CHECK(res);
+        CHECK(res.value() == ";");
+        CHECK(sink.log == "abc = 123 ");
+    }
+
+    SECTION("Discarded outputs are not reported")
+    {
+        EventLog sink;
+        CHECK(parse_events(tpl(skip(alpha1), preceded(ch('('), digit1), terminated(alpha1, ch(')')), delimited(ch('['), alpha1, ch(']'))), "ab(1c)[d]", sink));
+        CHECK(sink.log == "1 c d ");
+    }
+
+    SECTION("Events around tagged matches")
+    {
+        const auto pair = event<PairTag>(tpl(alpha1, skip(ch(':')), digit1));
+        const auto list = event<ListTag>(delimited(ch('{'), separated0(ch(','), pair), ch('}')));
+
+        EventLog sink;
+        CHECK(parse_events(list, "{a:1,b:2}", sink));
+        CHECK(sink.log == "<list <pair a 1 pair> <pair b 2 pair> list> ");
+    }
+
+    SECTION("Alternatives failing on their first parser report nothing")
+    {
+        const auto pair = event<PairTag>(tpl(ch('('), alpha1, ch(')')));
+        const auto list = event<ListTag>(tpl(ch('['), alpha1, ch(']')));
+
+        EventLog sink;
+        CHECK(parse_events(alt(pair, list), "[x]", sink));
+        CHECK(sink.log == "<list [ x ] list> ");
+
+        EventLog failed;
+        CHECK_FALSE(parse_events(alt(pair, list), "{x}", failed));
+        CHECK(failed.log == "");
+    }
+
+    SECTION("Alternatives failing after their first parser report nothing")
+    {
+        const auto pair = event<PairTag>(tpl(digit1, ch('x')));
+        const auto list = event<ListTag>(tpl(digit1, ch('y')));
+
+        EventLog sink;
+        CHECK(parse_events(alt(pair, list), "12y", sink));
+        CHECK(sink.log == "<list 12 y list> ");
+
+        EventLog nested;
+        CHECK(parse_events(alt(tpl(pair, ch(';')), tpl(list, ch(';')), pair), "12x!", nested));
+        CHECK(nested.log == "<pair 12 x pair> ");
+    }
+
+    SECTION("List ending in an element matched in part reports the whole elements")
+    {
+        const auto pair = event<PairTag>(tpl(alpha1, ch('='), digit1));
+
+        EventLog sink;
+        const auto res = parse_events(separated0(ch(','), pair), "a=1,b=2,c", sink);
+        REQUIRE(res);
+        CHECK(res.value() == ",c");
+        CHECK(sink.log == "<pair a = 1 pair> <pair b = 2 pair> ");
+
+        EventLog first;
+        CHECK(parse_events(separated0(ch(','), pair), "a=", first).value() == "a=");
+        CHECK(first.log == "");
+    }
+
+    SECTION("Failed match after a start still ends it")
+    {
+        EventLog sink;
+        CHECK_FALSE(parse_events(event<PairTag>(tpl(digit1, ch('x'))), "12y", sink));
+        CHECK(sink.log == "<pair 12 pair> ");
+    }
+
+    SECTION("Same match as parse")
+    {
+        const auto p = tpl(alpha1, skip(multispace1), digit1);
+        EventLog sink;
+        CHECK(parse_events(p, "abc 12x", sink).value() == efp::fst(p("abc 12x").value()));
+    }
+}
+
+// Parser which counts its live copies, and whose copies throw once copies_left runs out
+struct CountedParser
+{
+    int *live;
+    int *copies_left;
+
+    CountedParser(int *live, int *copies_left)
+        : live(live), copies_left(copies_left)
+    {
+        ++*live;
+    }
+
+    CountedParser(const CountedParser &other)
+        : live(other.live), copies_left(other.copies_left)
+    {
+        if (*copies_left == 0)
+            throw std::runtime_error("copy failed");
+
+        --*copies_left;
+        ++*live;
+    }
+
+    ~CountedParser()
+    {
+        --*live;
+    }
+
+    auto operator()(const efp::StringView &in) const -> Parsed<efp::StringView, efp::StringView>
+    {
+        return efp::tuple(in, in);
+    }
+};
+
+TEST_CASE("Rule works correctly", "[rule]")
+{
+    SECTION("Undefined rule fails")
+    {
+        Rule<efp::StringView, efp::StringView> rule;
+        CHECK_FALSE(rule("abc"));
+    }
+
+    SECTION("Rule could be redefined")
+    {
+        Rule<efp::StringView, efp::StringView> rule;
+        rule = tag("a");
+        CHECK(rule("abc"));
+
+        rule = digit1;
+        CHECK_FALSE(rule("abc"));
+        CHECK(rule("123"));
+    }
+
+    SECTION("Rule is left undefined if the parser could not be copied")
+    {
+        int live = 0;
+        int copies_left = 2;
+        {
+            const CountedParser p(&live, &copies_left);
+            Rule<efp::StringView, efp::StringView> rule;
+            rule = p;
+            CHECK(rule("abc"));
+            CHECK(live == 2);
+
+            // The copy into the rule throws, after the temporary one
+            copies_left = 1;
+            CHECK_THROWS(rule = p);
+            CHECK_FALSE(rule("abc"));
+            CHECK(live == 1);
+        }
+        CHECK(live == 0);
+    }
+
+    SECTION("Recursive rule")
+    {
+        // expr := digit1 | '(' expr ')'
+        Rule<efp::StringView, efp::StringView> expr;
+        const auto parens = tpl(ch('('), ref(expr), ch(')'));
+
+        expr = alt(digit1, [=](const efp::StringView &in) -> Parsed<efp::StringView, efp::StringView>
+                   {
+                       const auto res = parens(in);
+                       if (!res)
+                           return efp::nothing;
+                       return efp::tuple(efp::fst(res.value()), efp::p<1>(efp::snd(res.value()))); });
+
+        {
+            auto result = expr("((42))rest");
+            CHECK(result);
+            if (result)
+            {
+                CHECK(fst(result.value()) == "rest");
+                CHECK(snd(result.value()) == "42");
+            }
+        }
+
+        {
+            auto result = expr("((42)rest");
+            CHECK_FALSE(result);
+        }
+    }
+
+    SECTION("Rule given a sink reports the events of its parser, not its output")
+    {
+        // list := '[' (list | digits) (',' (list | digits))* ']', where digits are separated by '_'
+        Rule<efp::StringView, size_t, 256, EventLog> list;
+        list = event<ListTag>(delimited(ch('['), separated0(ch(','), alt(ref(list), separated0(ch('_'), digit1))), ch(']')));
+
+        EventLog sink;
+        const auto res = parse_events(list, "[1,[2,3_4],5]x", sink);
+        REQUIRE(res);
+        CHECK(res.value() == "x");
+        CHECK(sink.log == "<list 1 <list 2 3 4 list> 5 list> ");
+
+        EventLog failed;
+        CHECK_FALSE(parse_events(list, "[1,[2", failed));
+        CHECK(failed.log == "<list 1 list> ");
+    }
+}
+
 #endif
\ No newline at end of file
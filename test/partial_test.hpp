@@ -0,0 +1,264 @@
+#ifndef PARTIAL_TEST_HPP_
+#define PARTIAL_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+#include "test_common.hpp"
+
+using namespace efp::parser;
+
+// Partial mode on each part of the input received so far either waits for more, or has the result on the whole input
+template <typename P>
+void check_partial(const P &p, const char *input)
+{
+    const efp::StringView in(input);
+    const auto res = p(in);
+
+    for (size_t n = 0; n <= length(in); ++n)
+    {
+        const auto part = partial(p, take(n, in));
+        if (part.status == PartialStatus::Incomplete)
+            continue;
+
+        REQUIRE(static_cast<bool>(part) == static_cast<bool>(res));
+        check_same_result(res, in, n, part.parsed);
+    }
+}
+
+template <typename P>
+PartialStatus partial_status(const P &p, const efp::StringView &in)
+{
+    return partial(p, in).status;
+}
+
+TEST_CASE("partial works correctly", "[partial]")
+{
+    SECTION("Runs of characters wait for the character which ends them")
+    {
+        CHECK(partial_status(digit1, "") == PartialStatus::Incomplete);
+        CHECK(partial_status(digit1, "12") == PartialStatus::Incomplete);
+        CHECK(partial_status(digit1, "12x") == PartialStatus::Matched);
+        CHECK(partial_status(digit1, "x") == PartialStatus::Failed);
+        CHECK(partial_status(space0, "x") == PartialStatus::Matched);
+
+        for (const char *in : character_inputs)
+        {
+            check_partial(alpha0, in);
+            check_partial(alpha1, in);
+            check_partial(alphanumeric1, in);
+            check_partial(digit1, in);
+            check_partial(hex_digit1, in);
+            check_partial(oct_digit0, in);
+            check_partial(multispace1, in);
+            check_partial(space1, in);
+            check_partial(not_line_ending, in);
+            check_partial(line_ending, in);
+            check_partial(crlf, in);
+            check_partial(anychar, in);
+            check_partial(one_of("\r\n "), in);
+            check_partial(none_of("\r\n "), in);
+        }
+    }
+
+    SECTION("Integers wait for the character after their digits")
+    {
+        CHECK(partial_status(parse_int32, "-") == PartialStatus::Incomplete);
+        CHECK(partial_status(parse_int32, "-12") == PartialStatus::Incomplete);
+        CHECK(partial_status(parse_int32, "-12;") == PartialStatus::Matched);
+        CHECK(partial_status(parse_uint32, "-1") == PartialStatus::Failed);
+        CHECK(partial_status(parse_uint8, "256 ") == PartialStatus::Failed);
+
+        for (const char *in : integer_inputs)
+        {
+            check_partial(parse_uint8, in);
+            check_partial(parse_int8, in);
+            check_partial(parse_uint32, in);
+            check_partial(parse_int64, in);
+        }
+    }
+
+    SECTION("Tags wait while the input is a part of them")
+    {
+        CHECK(partial_status(tag("GET"), "GE") == PartialStatus::Incomplete);
+        CHECK(partial_status(tag("GET"), "GX") == PartialStatus::Failed);
+        CHECK(partial_status(tag("GET"), "GET") == PartialStatus::Matched);
+        CHECK(partial_status(ch('a'), "") == PartialStatus::Incomplete);
+        CHECK(partial_status(ch('a'), "b") == PartialStatus::Failed);
+    }
+
+    SECTION("Binary numbers and varints")
+    {
+        CHECK(partial_status(be_u16, efp::StringView("\x01", 1)) == PartialStatus::Incomplete);
+        CHECK(partial_status(be_u16, efp::StringView("\x01\x02", 2)) == PartialStatus::Matched);
+        CHECK(partial_status(varint_u32, efp::StringView("\x80\x80", 2)) == PartialStatus::Incomplete);
+        CHECK(partial_status(varint_u32, efp::StringView("\x80\x01", 2)) == PartialStatus::Matched);
+        CHECK(partial_status(varint_u32, efp::StringView("\x80\x80\x80\x80\x80", 5)) == PartialStatus::Failed);
+        CHECK(partial_status(varint_u64, efp::StringView("\x80\x80\x80\x80\x80", 5)) == PartialStatus::Incomplete);
+
+        const auto res = partial(varint_u32, efp::StringView("\xC8\x01x", 3));
+        REQUIRE(res);
+        CHECK(efp::snd(res.parsed.value()) == 200);
+        CHECK(efp::fst(res.parsed.value()) == "x");
+    }
+
+    SECTION("Sequences wait on the parser which reached the end")
+    {
+        const auto metric = tpl(alpha1, ch(' '), parse_uint32, line_ending);
+
+        CHECK(partial_status(metric, "cpu") == PartialStatus::Incomplete);
+        CHECK(partial_status(metric, "cpu 42\r") == PartialStatus::Incomplete);
+        CHECK(partial_status(metric, "cpu x") == PartialStatus::Failed);
+        CHECK(partial_status(metric, "1") == PartialStatus::Failed);
+
+        const auto res = partial(metric, "cpu 42\r\nmem");
+        REQUIRE(res);
+        CHECK(efp::p<2>(efp::snd(res.parsed.value())) == 42);
+        CHECK(efp::fst(res.parsed.value()) == "mem");
+    }
+
+    SECTION("Alternatives wait on the first one which could still match")
+    {
+        const auto methods = alt(value(tag("GET"), 1), value(tag("GEX"), 2), map(digit1, [](efp::StringView s)
+                                                                                   { return static_cast<int>(length(s)) + 2; }));
+
+        CHECK(partial_status(methods, "GE") == PartialStatus::Incomplete);
+        CHECK(partial_status(methods, "G") == PartialStatus::Incomplete);
+        CHECK(partial_status(methods, "GO") == PartialStatus::Failed);
+        CHECK(partial_status(methods, "12") == PartialStatus::Incomplete);
+
+        const auto res = partial(methods, "GEX");
+        REQUIRE(res);
+        CHECK(efp::snd(res.parsed.value()) == 2);
+
+        const auto number = partial(methods, "123 ");
+        REQUIRE(number);
+        CHECK(efp::snd(number.parsed.value()) == 5);
+    }
+
+    SECTION("Preceded, terminated and delimited wait on the parser which reached the end")
+    {
+        const auto version = preceded(ch('v'), parse_uint8);
+        const auto line = terminated(digit1, line_ending);
+        const auto list = delimited(ch('['), separated0(ch(','), parse_int32), ch(']'));
+
+        CHECK(partial_status(version, "v") == PartialStatus::Incomplete);
+        CHECK(partial_status(version, "v12") == PartialStatus::Incomplete);
+        CHECK(partial_status(version, "v12;") == PartialStatus::Matched);
+        CHECK(partial_status(version, "x") == PartialStatus::Failed);
+        CHECK(partial_status(line, "12\r") == PartialStatus::Incomplete);
+        CHECK(partial_status(line, "12\n") == PartialStatus::Matched);
+        CHECK(partial_status(line, "12x") == PartialStatus::Failed);
+        CHECK(partial_status(list, "[1,2") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "[1,-") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "[1;") == PartialStatus::Failed);
+
+        const auto res = partial(list, "[1,-2,3]x");
+        REQUIRE(res);
+        CHECK(efp::snd(res.parsed.value()) == 3);
+        CHECK(efp::fst(res.parsed.value()) == "x");
+    }
+
+    SECTION("Lists wait while the separator or the element after it is incomplete")
+    {
+        const auto list = separated0(tag(", "), digit1);
+
+        CHECK(partial_status(list, "") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "1,") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "1, ") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "1, 2") == PartialStatus::Incomplete);
+        CHECK(partial_status(list, "1;") == PartialStatus::Matched);
+        CHECK(partial_status(list, "x") == PartialStatus::Matched);
+
+        const auto res = partial(list, "1, 2, x");
+        REQUIRE(res);
+        CHECK(efp::snd(res.parsed.value()) == 2);
+        CHECK(efp::fst(res.parsed.value()) == ", x");
+    }
+
+    SECTION("map_res and verify wait for their parser, and check only a match")
+    {
+        const auto even = verify(parse_uint32, [](uint32_t n)
+                                 { return n % 2 == 0; });
+        const auto small = map_res(parse_uint32, [](uint32_t n) -> efp::Maybe<uint32_t>
+                                   { if (n > 9) return efp::nothing; return n; });
+
+        CHECK(partial_status(even, "7") == PartialStatus::Incomplete);
+        CHECK(partial_status(even, "7 ") == PartialStatus::Failed);
+        CHECK(partial_status(even, "8 ") == PartialStatus::Matched);
+        CHECK(partial_status(small, "1") == PartialStatus::Incomplete);
+        CHECK(partial_status(small, "12 ") == PartialStatus::Failed);
+        CHECK(partial_status(small, "7 ") == PartialStatus::Matched);
+    }
+
+    SECTION("Escaped strings wait for the closing quote and for the rest of an escape")
+    {
+        CHECK(partial_status(escaped_string, "") == PartialStatus::Incomplete);
+        CHECK(partial_status(escaped_string, "\"ab") == PartialStatus::Incomplete);
+        CHECK(partial_status(escaped_string, "\"ab\\") == PartialStatus::Incomplete);
+        CHECK(partial_status(escaped_string, "\"a\\u00") == PartialStatus::Incomplete);
+        CHECK(partial_status(escaped_string, "\"a\\uD83D") == PartialStatus::Incomplete);
+        CHECK(partial_status(escaped_string, "\"ab\"") == PartialStatus::Matched);
+        CHECK(partial_status(escaped_string, "x") == PartialStatus::Failed);
+        CHECK(partial_status(escaped_string, "\"a\\q") == PartialStatus::Failed);
+        CHECK(partial_status(escaped_string, "\"a\x01") == PartialStatus::Failed);
+
+        const auto raw = map(escaped_string, [](EscapedString s)
+                             { return s.raw; });
+        const auto member = tpl(raw, ch(':'), parse_int32);
+
+        const char *inputs[] = {"\"ab\" x", "\"a\\n\\u00e9\"", "\"\\uD83D\\uDE00\"", "\"a\\q\"", "\"a\x01\"", "\"k\":-12,",
+                                "\"k\";", "\"abc", "", "x"};
+        for (const char *in : inputs)
+        {
+            check_partial(raw, in);
+            check_partial(member, in);
+        }
+    }
+
+    SECTION("A Rule declared with partial runs its parser in partial mode")
+    {
+        Rule<efp::StringView, size_t, 256, void, true> list;
+        list = delimited(ch('['), separated0(ch(','), alt(ref(list), value(digit1, size_t(1)))), ch(']'));
+
+        CHECK(partial_status(ref(list), "[1,[2") == PartialStatus::Incomplete);
+        CHECK(partial_status(ref(list), "[1,[2]") == PartialStatus::Incomplete);
+        CHECK(partial_status(ref(list), "[1,[x") == PartialStatus::Failed);
+
+        const auto res = partial(ref(list), "[1,[2,3],4]x");
+        REQUIRE(res);
+        CHECK(efp::snd(res.parsed.value()) == 3);
+        CHECK(efp::fst(res.parsed.value()) == "x");
+
+        const char *inputs[] = {"[1,[2,3],4]x", "[[]]", "[1,]", "[1;", "", "x"};
+        for (const char *in : inputs)
+            check_partial(ref(list), in);
+    }
+
+    SECTION("Combinators agree with the parser on the whole input")
+    {
+        const auto header = tpl(ch('v'), parse_uint8, ch('.'), parse_uint8, tag(" "), alpha1, line_ending);
+        const auto methods = alt(value(tag("GET"), size_t(1)), value(tag("HEAD"), size_t(2)), value(tag("POST"), size_t(3)),
+                                 map(digit1, [](efp::StringView s)
+                                     { return length(s); }));
+        const auto longest = alt(value(tpl(ch('a'), ch('b'), ch('c')), 3), value(ch('a'), 1));
+        const auto digits = map(skip_digit1, [](Skipped)
+                                { return 0; });
+
+        for (const char *in : combinator_inputs)
+        {
+            check_partial(header, in);
+            check_partial(methods, in);
+            check_partial(longest, in);
+            check_partial(digits, in);
+            check_partial(preceded(ch('v'), parse_uint8), in);
+            check_partial(terminated(alpha1, line_ending), in);
+            check_partial(delimited(ch('a'), digit0, ch('!')), in);
+            check_partial(separated0(ch('.'), parse_uint8), in);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef ROPE_TEST_HPP_
+#define ROPE_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("Rope works correctly", "[rope]")
+{
+    const efp::StringView segments[] = {"hel", "", "lo wo", "rld"};
+    const Rope in(segments, 4);
+
+    SECTION("Rope covers all the segments")
+    {
+        CHECK(length(in) == 11);
+        CHECK(in == "hello world");
+        CHECK(in.head() == "hel");
+        CHECK_FALSE(in.contiguous());
+    }
+
+    SECTION("drop and take across the segments")
+    {
+        CHECK(drop(2, in) == "llo world");
+        CHECK(drop(3, in).head() == "lo wo");
+        CHECK(drop(9, in) == "ld");
+        CHECK(drop(11, in).empty());
+        CHECK(take(5, in) == "hello");
+        CHECK(take(4, drop(4, in)) == "o wo");
+        CHECK(take(4, drop(4, in)).contiguous());
+        CHECK(drop(2, take(5, in)) == "llo");
+    }
+
+    SECTION("copy_to gathers the segments")
+    {
+        std::string out(length(in), ' ');
+        in.copy_to(&out[0]);
+        CHECK(out == "hello world");
+    }
+}
+
+TEST_CASE("Parsers accept Rope", "[rope]")
+{
+    SECTION("Token within the head is a view of its segment")
+    {
+        const efp::StringView segments[] = {"abc 12", "3;"};
+        const auto res = alpha1(Rope(segments, 2));
+
+        REQUIRE(res);
+        CHECK(snd(res.value()) == "abc");
+        CHECK(snd(res.value()).contiguous());
+        CHECK(snd(res.value()).head().data() == segments[0].data());
+        CHECK(fst(res.value()) == " 123;");
+    }
+
+    SECTION("Tokens across the segments")
+    {
+        const efp::StringView segments[] = {"ab", "c 12", "3", ";GE", "T"};
+        const auto res = tpl(alpha1, ch(' '), parse_uint32, ch(';'), tag("GET"))(Rope(segments, 5));
+
+        REQUIRE(res);
+        CHECK(efp::p<0>(snd(res.value())) == "abc");
+        CHECK(efp::p<2>(snd(res.value())) == 123);
+        CHECK(efp::p<4>(snd(res.value())) == "GET");
+        CHECK(fst(res.value()).empty());
+    }
+
+    SECTION("Every split of a message parses as the contiguous message")
+    {
+        const std::string message = "key=65535;name=value;\r\n";
+        const auto field = tpl(alpha1, ch('='), alt(map(parse_uint16, [](uint16_t) { return 0; }),
+                                                    map(alphanumeric1, [](Rope) { return 1; })),
+                               ch(';'));
+        const auto line = tpl(field, field, line_ending);
+
+        for (size_t i = 0; i <= message.size(); ++i)
+        {
+            for (size_t j = i; j <= message.size(); ++j)
+            {
+                const efp::StringView segments[] = {efp::StringView(message.data(), i),
+                                                    efp::StringView(message.data() + i, j - i),
+                                                    efp::StringView(message.data() + j, message.size() - j)};
+                const auto res = line(Rope(segments, 3));
+
+                REQUIRE(res);
+                CHECK(efp::p<0>(efp::p<0>(snd(res.value()))) == "key");
+                CHECK(efp::p<2>(efp::p<0>(snd(res.value()))) == 0);
+                CHECK(efp::p<0>(efp::p<1>(snd(res.value()))) == "name");
+                CHECK(efp::p<2>(efp::p<1>(snd(res.value()))) == 1);
+                CHECK(fst(res.value()).empty());
+            }
+        }
+    }
+
+    SECTION("Sequences within the head run on the segment")
+    {
+        const efp::StringView segments[] = {"ab=12;cd=3", "4;"};
+        const auto record = tpl(tpl(alpha1, ch('=')), digit1, ch(';'));
+        const auto first = record(Rope(segments, 2));
+
+        REQUIRE(first);
+        CHECK(efp::p<0>(efp::p<0>(snd(first.value()))) == "ab");
+        CHECK(efp::p<1>(snd(first.value())) == "12");
+
+        const auto second = record(fst(first.value()));
+
+        REQUIRE(second);
+        CHECK(efp::p<1>(snd(second.value())) == "34");
+        CHECK_FALSE(efp::p<1>(snd(second.value())).contiguous());
+        CHECK(fst(second.value()).empty());
+    }
+
+    SECTION("Alternatives and lists across the segments match as on the contiguous input")
+    {
+        const auto longest = alt(map(tpl(ch('a'), ch('b'), ch('c')), [](const efp::Tuple<char, char, char> &)
+                                     { return 3; }),
+                                 map(ch('a'), [](char)
+                                     { return 1; }));
+        const efp::StringView segments[] = {"ab", "c!"};
+
+        const auto contiguous = longest("abc!");
+        const auto res = longest(Rope(segments, 2));
+
+        REQUIRE(contiguous);
+        REQUIRE(res);
+        CHECK(snd(res.value()) == snd(contiguous.value()));
+        CHECK(fst(res.value()) == "!");
+
+        const auto keyed = tpl(alpha1, ch('='), longest);
+        const efp::StringView keyed_segments[] = {"k=ab", "c!"};
+        const auto keyed_res = keyed(Rope(keyed_segments, 2));
+
+        REQUIRE(keyed_res);
+        CHECK(efp::p<2>(snd(keyed_res.value())) == 3);
+        CHECK(fst(keyed_res.value()) == "!");
+
+        const auto list = separated0(ch(','), tpl(alpha1, ch(';')));
+        const efp::StringView list_segments[] = {"a;,b", ";,c;!"};
+        const auto list_res = list(Rope(list_segments, 2));
+
+        REQUIRE(list_res);
+        CHECK(snd(list_res.value()) == 3);
+        CHECK(fst(list_res.value()) == "!");
+    }
+
+    SECTION("Failures across the segments")
+    {
+        const efp::StringView segments[] = {"GE", "X"};
+
+        CHECK_FALSE(tag("GET")(Rope(segments, 2)));
+        CHECK_FALSE(digit1(Rope(segments, 2)));
+    }
+}
+
+#endif
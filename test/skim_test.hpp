@@ -0,0 +1,86 @@
+#ifndef SKIM_TEST_HPP_
+#define SKIM_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+#include "json_parser.hpp"
+#include "test_common.hpp"
+
+using namespace efp::parser;
+
+// Skim mode matches as the parser does, and ends where it does
+template <typename P>
+void check_skim(const P &p, const char *input)
+{
+    const efp::StringView in(input);
+    check_same_end(p(in), in, length(in), skim(p, in));
+}
+
+TEST_CASE("skim works correctly", "[skim]")
+{
+    SECTION("Integers, within and beyond the digits of their type")
+    {
+        for (const char *in : integer_inputs)
+        {
+            check_skim(parse_uint8, in);
+            check_skim(parse_int8, in);
+            check_skim(parse_uint32, in);
+            check_skim(parse_int64, in);
+        }
+
+        check_skim(parse_uint64, "18446744073709551615");
+        check_skim(parse_uint64, "18446744073709551616");
+    }
+
+    SECTION("JSON numbers")
+    {
+        const char *inputs[] = {"0", "-0.5e+3,", "12.", "1e", "01", "-", "3.14159265358979323846", "x"};
+        for (const char *in : inputs)
+            check_skim(json_number, in);
+    }
+
+    SECTION("Combinators")
+    {
+        const auto header = tpl(ch('v'), parse_uint8, skip(ch('.')), parse_uint8, tag(" "), alpha1, line_ending);
+        const auto fixed = tpl(ch('a'), ch('b'), crlf, ch('c'), digit1);
+        const auto methods = alt(value(tag("GET"), size_t(1)), value(tag("HEAD"), size_t(2)), value(tag("POST"), size_t(3)),
+                                 map(digit1, [](efp::StringView s)
+                                     { return length(s); }));
+        const auto list = delimited(ch('['), separated0(ch(','), parse_int32), ch(']'));
+        const auto checked = verify(parse_uint32, [](uint32_t n)
+                                    { return n % 2 == 0; });
+        const auto converted = map_res(parse_uint32, [](uint32_t n) -> efp::Maybe<uint32_t>
+                                       { if (n > 9) return efp::nothing; return n; });
+
+        for (const char *in : combinator_inputs)
+        {
+            check_skim(header, in);
+            check_skim(fixed, in);
+            check_skim(methods, in);
+            check_skim(list, in);
+            check_skim(checked, in);
+            check_skim(converted, in);
+            check_skim(preceded(ch('v'), parse_uint8), in);
+            check_skim(terminated(digit1, ch('x')), in);
+            check_skim(event<struct SkimTag>(parse_uint8), in);
+        }
+    }
+
+    SECTION("Rule")
+    {
+        Rule<efp::StringView, size_t> nested;
+        nested = alt(map(delimited(ch('('), ref(nested), ch(')')), [](size_t n)
+                         { return n + 1; }),
+                     map(parse_uint8, [](uint8_t)
+                         { return size_t(0); }));
+
+        check_skim(nested, "((7))");
+        check_skim(nested, "((7)");
+        check_skim(nested, "((300))");
+    }
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef STEP_TEST_HPP_
+#define STEP_TEST_HPP_
+
+#include <type_traits>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+#include "test_common.hpp"
+
+using namespace efp::parser;
+
+// Step mode matches as the parser does, and converts back to its result
+template <typename P>
+void check_step(const P &p, const char *input)
+{
+    const efp::StringView in(input);
+    const auto res = p(in);
+    const auto stepped = step(p, in);
+
+    REQUIRE(static_cast<bool>(stepped) == static_cast<bool>(res));
+    check_same_result(res, in, length(in), to_parsed(stepped, in));
+}
+
+static_assert(std::is_trivially_copyable<Step<Matched>>::value && sizeof(Step<Matched>) == 8,
+              "A run of characters is a step of its end alone");
+static_assert(std::is_trivially_copyable<Step<uint64_t>>::value && sizeof(Step<uint64_t>) == 16,
+              "A step of an integer fits in two registers");
+
+TEST_CASE("step works correctly", "[step]")
+{
+    SECTION("Runs of characters")
+    {
+        for (const char *in : character_inputs)
+        {
+            check_step(alpha0, in);
+            check_step(alpha1, in);
+            check_step(alphanumeric1, in);
+            check_step(digit0, in);
+            check_step(digit1, in);
+            check_step(hex_digit1, in);
+            check_step(oct_digit1, in);
+            check_step(multispace1, in);
+            check_step(space0, in);
+            check_step(space1, in);
+            check_step(not_line_ending, in);
+            check_step(line_ending, in);
+        }
+    }
+
+    SECTION("Characters")
+    {
+        for (const char *in : character_inputs)
+        {
+            check_step(anychar, in);
+            check_step(one_of("ax-"), in);
+            check_step(none_of("ax-"), in);
+            check_step(ch('a'), in);
+            check_step(crlf, in);
+            check_step(tag("ab"), in);
+        }
+    }
+
+    SECTION("Integers, within and beyond the range of their type")
+    {
+        for (const char *in : integer_inputs)
+        {
+            check_step(parse_uint8, in);
+            check_step(parse_int8, in);
+            check_step(parse_uint32, in);
+            check_step(parse_int64, in);
+        }
+
+        check_step(parse_uint64, "18446744073709551615");
+        check_step(parse_uint64, "18446744073709551616");
+        check_step(parse_int64, "-9223372036854775808");
+        check_step(parse_int64, "-9223372036854775809");
+    }
+
+    SECTION("Parsers without their own step")
+    {
+        check_step(map(digit1, [](efp::StringView s)
+                       { return length(s); }),
+                   "123x");
+        check_step(preceded(ch('v'), parse_uint8), "v12");
+        check_step(preceded(ch('v'), parse_uint8), "x12");
+    }
+
+    SECTION("Empty matches of a view with no data")
+    {
+        const efp::StringView empty;
+
+        const auto stepped = step(alpha0, empty);
+        REQUIRE(stepped);
+        CHECK(length(efp::snd(to_parsed(stepped, empty).value())) == 0);
+
+        const auto number = step(parse_uint8, empty);
+        CHECK_FALSE(number);
+        CHECK_FALSE(to_parsed(number, empty));
+
+        const auto res = tpl(alpha0, digit0)(empty);
+        REQUIRE(res);
+        CHECK(length(efp::fst(res.value())) == 0);
+        CHECK(length(efp::p<0>(efp::snd(res.value()))) == 0);
+        CHECK(length(efp::p<1>(efp::snd(res.value()))) == 0);
+
+        CHECK_FALSE(tpl(alpha0, digit1)(empty));
+    }
+
+    SECTION("TupleParser matches the same on StringView as on Cursor")
+    {
+        const auto record = tpl(alpha1, ch('='), parse_int32, space0, hex_digit1, tag(";"), line_ending);
+        const auto mixed = tpl(digit1, map(alpha1, [](const auto &s)
+                                           { return length(s); }),
+                               parse_uint16, separated0(ch(','), one_of("ab")), not_line_ending);
+
+        const char *inputs[] = {"key=-12 ff;\nnext", "key=12ff;\r\n", "key=12 ff;", "key=x", "1abc65535a,b tail",
+                                "1abc65536a,b", "1abc7", ""};
+        for (const char *in : inputs)
+        {
+            const auto res = record(efp::StringView(in));
+            const auto res_cursor = record(Cursor(efp::StringView(in)));
+
+            REQUIRE(static_cast<bool>(res) == static_cast<bool>(res_cursor));
+            if (res)
+                CHECK(length(efp::fst(res.value())) == length(efp::fst(res_cursor.value())));
+
+            const auto res_mixed = mixed(efp::StringView(in));
+            const auto res_mixed_cursor = mixed(Cursor(efp::StringView(in)));
+
+            REQUIRE(static_cast<bool>(res_mixed) == static_cast<bool>(res_mixed_cursor));
+            if (res_mixed)
+                CHECK(efp::p<1>(efp::snd(res_mixed.value())) == efp::p<1>(efp::snd(res_mixed_cursor.value())));
+        }
+
+        const auto res = record("key=-12 ff;\nnext");
+        REQUIRE(res);
+        CHECK(efp::fst(res.value()) == efp::StringView("next"));
+        CHECK(efp::p<0>(efp::snd(res.value())) == efp::StringView("key"));
+        CHECK(efp::p<2>(efp::snd(res.value())) == -12);
+        CHECK(efp::p<4>(efp::snd(res.value())) == efp::StringView("ff"));
+        CHECK(efp::p<6>(efp::snd(res.value())) == efp::StringView("\n"));
+    }
+}
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef STREAM_TEST_HPP_
+#define STREAM_TEST_HPP_
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+#if defined(EFP_PARSER_COROUTINE) && defined(__unix__)
+#include <exception>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace efp::parser;
+
+TEST_CASE("MessageStream works correctly", "[MessageStream]")
+{
+    const auto metric = tpl(alpha1, ch(' '), parse_uint32);
+
+    SECTION("Delimited messages fed a byte at a time")
+    {
+        MessageStream<DelimiterFramer> stream(delimiter_framer("\r\n"));
+        const std::string bytes = "cpu 42\r\nmem 7\r\n";
+
+        std::vector<uint32_t> values;
+        for (const char c : bytes)
+        {
+            stream.feed(&c, 1);
+            const auto msg = stream.poll(metric);
+            if (msg)
+                values.push_back(efp::p<2>(msg.value()));
+        }
+
+        REQUIRE(values.size() == 2);
+        CHECK(values[0] == 42);
+        CHECK(values[1] == 7);
+
+        stream.close();
+        CHECK_FALSE(stream.poll(metric));
+        CHECK(stream.status() == StreamStatus::Closed);
+    }
+
+    SECTION("Several messages in a single read")
+    {
+        MessageStream<DelimiterFramer> stream(delimiter_framer("\r\n"));
+        const std::string bytes = "a 1\r\nb 2\r\nc 3\r\nd";
+        stream.feed(bytes.data(), bytes.size());
+
+        const auto a = stream.poll(metric);
+        REQUIRE(a);
+        CHECK(efp::p<0>(a.value()) == "a");
+        CHECK(stream.poll(metric));
+        CHECK(stream.poll(metric));
+        CHECK_FALSE(stream.poll(metric));
+        CHECK(stream.status() == StreamStatus::Open);
+        CHECK(stream.buffered() == 1);
+
+        stream.close();
+        CHECK_FALSE(stream.poll(metric));
+        CHECK(stream.status() == StreamStatus::Failed);
+    }
+
+    SECTION("Length prefixed messages")
+    {
+        MessageStream<LengthPrefixFramer<BinaryParser<uint16_t, true>>> stream(length_prefix_framer(be_u16));
+        const std::string bytes("\x00\x06" "disk 9" "\x00\x05" "net 3", 15);
+
+        std::vector<std::string> names;
+        for (size_t i = 0; i < bytes.size(); i += 4)
+        {
+            stream.feed(bytes.data() + i, std::min<size_t>(4, bytes.size() - i));
+            while (true)
+            {
+                const auto msg = stream.poll(metric);
+                if (!msg)
+                    break;
+                const auto name = efp::p<0>(msg.value());
+                names.push_back(std::string(name.data(), length(name)));
+            }
+        }
+
+        REQUIRE(names.size() == 2);
+        CHECK(names[0] == "disk");
+        CHECK(names[1] == "net");
+    }
+
+    SECTION("Varint length of several bytes, split over the reads")
+    {
+        MessageStream<LengthPrefixFramer<VarintParser<uint32_t>>> stream(length_prefix_framer(varint_u32));
+        const std::string bytes = std::string("\xC8\x01", 2) + std::string(200, 'a');
+
+        stream.feed(bytes.data(), 1);
+        CHECK_FALSE(stream.poll(alpha1));
+        stream.feed(bytes.data() + 1, 100);
+        CHECK_FALSE(stream.poll(alpha1));
+        stream.feed(bytes.data() + 101, bytes.size() - 101);
+
+        const auto msg = stream.poll(alpha1);
+        REQUIRE(msg);
+        CHECK(length(msg.value()) == 200);
+        CHECK(stream.buffered() == 0);
+    }
+
+    SECTION("A message which does not match fails the stream")
+    {
+        MessageStream<DelimiterFramer> stream(delimiter_framer("\n"));
+        const std::string bytes = "cpu x\nmem 1\n";
+        stream.feed(bytes.data(), bytes.size());
+
+        CHECK_FALSE(stream.poll(metric));
+        CHECK(stream.status() == StreamStatus::Failed);
+        CHECK_FALSE(stream.poll(metric));
+    }
+
+    SECTION("A message over the maximum length fails the stream")
+    {
+        MessageStream<DelimiterFramer> stream(delimiter_framer("\n", 8));
+        const std::string bytes = "0123456789";
+        stream.feed(bytes.data(), bytes.size());
+
+        CHECK_FALSE(stream.poll(metric));
+        CHECK(stream.status() == StreamStatus::Failed);
+    }
+
+    SECTION("Messages framed by their parser, fed a byte at a time")
+    {
+        const auto line = tpl(alpha1, ch(' '), parse_uint32, line_ending);
+        MessageStream<ParserFramer<std::decay<decltype(line)>::type>> stream(parser_framer(line));
+        const std::string bytes = "cpu 42\nmem 7\r\n";
+
+        std::vector<uint32_t> values;
+        for (const char c : bytes)
+        {
+            stream.feed(&c, 1);
+            const auto msg = stream.poll(line);
+            if (msg)
+                values.push_back(efp::p<2>(msg.value()));
+        }
+
+        REQUIRE(values.size() == 2);
+        CHECK(values[0] == 42);
+        CHECK(values[1] == 7);
+
+        stream.close();
+        CHECK_FALSE(stream.poll(line));
+        CHECK(stream.status() == StreamStatus::Closed);
+    }
+
+    SECTION("The end of the stream decides the last message framed by its parser")
+    {
+        const auto pair = tpl(alpha1, ch('='), parse_uint32);
+        MessageStream<ParserFramer<std::decay<decltype(pair)>::type>> stream(parser_framer(pair));
+        const std::string bytes = "a=1b=23";
+        stream.feed(bytes.data(), bytes.size());
+
+        const auto a = stream.poll(pair);
+        REQUIRE(a);
+        CHECK(efp::p<2>(a.value()) == 1);
+        CHECK_FALSE(stream.poll(pair));
+        CHECK(stream.buffered() == 4);
+
+        stream.close();
+        const auto b = stream.poll(pair);
+        REQUIRE(b);
+        CHECK(efp::p<2>(b.value()) == 23);
+        CHECK_FALSE(stream.poll(pair));
+        CHECK(stream.status() == StreamStatus::Closed);
+    }
+
+    SECTION("A message its parser could never match fails the stream at once")
+    {
+        const auto pair = tpl(alpha1, ch('='), parse_uint32);
+        MessageStream<ParserFramer<std::decay<decltype(pair)>::type>> stream(parser_framer(pair));
+        const std::string bytes = "a=x";
+        stream.feed(bytes.data(), bytes.size());
+
+        CHECK_FALSE(stream.poll(pair));
+        CHECK(stream.status() == StreamStatus::Failed);
+    }
+
+    SECTION("A message cut short by the end of the stream fails it")
+    {
+        const auto line = tpl(alpha1, ch(' '), parse_uint32, line_ending);
+        MessageStream<ParserFramer<std::decay<decltype(line)>::type>> stream(parser_framer(line));
+        const std::string bytes = "cpu 4";
+        stream.feed(bytes.data(), bytes.size());
+
+        CHECK_FALSE(stream.poll(line));
+        CHECK(stream.status() == StreamStatus::Open);
+
+        stream.close();
+        CHECK_FALSE(stream.poll(line));
+        CHECK(stream.status() == StreamStatus::Failed);
+    }
+}
+
+#if defined(EFP_PARSER_COROUTINE) && defined(__unix__)
+
+// Starts eagerly and is never awaited, as a connection handler of an event loop
+struct StreamTestTask
+{
+    struct promise_type
+    {
+        StreamTestTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename Framer, typename P>
+StreamTestTask handle_metrics(MessageStream<Framer> &stream, P metric, std::vector<uint32_t> &values, bool &done)
+{
+    while (true)
+    {
+        const auto msg = co_await stream.next(metric);
+        if (!msg)
+            break;
+        values.push_back(efp::p<2>(msg.value()));
+    }
+    done = true;
+}
+
+// Writes the metrics to a pipe in pieces, and feeds the stream whatever is readable after each
+template <typename Framer, typename P>
+void check_metrics_over_pipe(MessageStream<Framer> &stream, const P &metric)
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    REQUIRE(fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK) == 0);
+
+    std::vector<uint32_t> values;
+    bool done = false;
+
+    handle_metrics(stream, metric, values, done);
+    CHECK(values.empty());
+
+    // Reads whatever is available, as an event loop does on readiness
+    const auto on_readable = [&]()
+    {
+        char buffer[4];
+        while (true)
+        {
+            const auto n = read(fds[0], buffer, sizeof(buffer));
+            if (n <= 0)
+                break;
+            stream.feed(buffer, static_cast<size_t>(n));
+        }
+    };
+
+    const char *pieces[] = {"cp", "u 1", "2\nmem 3", "4\n", "disk", " 5\nnet 6\n"};
+    const size_t expected_counts[] = {0, 0, 1, 2, 2, 4};
+
+    for (size_t i = 0; i < 6; ++i)
+    {
+        REQUIRE(write(fds[1], pieces[i], strlen(pieces[i])) == static_cast<ssize_t>(strlen(pieces[i])));
+        on_readable();
+        CHECK(values.size() == expected_counts[i]);
+    }
+
+    CHECK(values == std::vector<uint32_t>{12, 34, 5, 6});
+    CHECK_FALSE(done);
+
+    close(fds[1]);
+    on_readable();
+    stream.close();
+    CHECK(done);
+    CHECK(stream.status() == StreamStatus::Closed);
+
+    close(fds[0]);
+}
+
+TEST_CASE("MessageStream resumes a coroutine as bytes arrive", "[MessageStream]")
+{
+    MessageStream<DelimiterFramer> stream(delimiter_framer("\n"));
+    check_metrics_over_pipe(stream, tpl(alpha1, ch(' '), parse_uint32));
+}
+
+TEST_CASE("MessageStream resumes a coroutine where the parser ran out of input", "[MessageStream]")
+{
+    const auto metric = tpl(alpha1, ch(' '), parse_uint32, line_ending);
+    MessageStream<ParserFramer<std::decay<decltype(metric)>::type>> stream(parser_framer(metric));
+    check_metrics_over_pipe(stream, metric);
+}
+
+#endif
+
+#endif
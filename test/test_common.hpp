@@ -0,0 +1,44 @@
+#ifndef TEST_COMMON_HPP_
+#define TEST_COMMON_HPP_
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+
+// Inputs for the runs of characters, of each class and line ending, and empty
+static const char *const character_inputs[] = {"abc12 x", "12ab", "  \t\r\n x", "\r\nx", "\nx", "\rx", "0777 8", "fF0g",
+                                               "", "-"};
+
+// Inputs for the integers, within and beyond the range of their type, each ended by a character which is not a digit
+static const char *const integer_inputs[] = {"0", "42abc", "255 ", "256 ", "00000000255,", "-128;", "-129;", "", "-", "x1"};
+
+// Inputs for the combinators of the mode tests, matched by some and cut short for others
+static const char *const combinator_inputs[] = {"v1.2 beta\n", "v1.256 beta\n", "v1.2 beta\r\n", "ab\r\nc12", "ab\nc12",
+                                                "GET /", "HEAD ", "POST", "12x", "[1,-2,3]x", "[1,2,", "[]", "abc!",
+                                                "ab!", "a", "8 ", "7 ", "12", "", "x"};
+
+// Mode equivalence
+// A mode which ran on the first n elements of in, and left rest of them, matches as the parser does on the whole of in
+// and ends where it does.
+
+template <typename R, typename M>
+void check_same_end(const R &res, const efp::StringView &in, size_t n, const M &rest)
+{
+    REQUIRE(static_cast<bool>(rest) == static_cast<bool>(res));
+    if (res)
+        CHECK(n - length(rest.value()) == length(in) - length(efp::fst(res.value())));
+}
+
+// As above, for a mode which has the output as well, which is that of the parser
+template <typename R, typename M>
+void check_same_result(const R &res, const efp::StringView &in, size_t n, const M &mode_res)
+{
+    REQUIRE(static_cast<bool>(mode_res) == static_cast<bool>(res));
+    if (res)
+    {
+        CHECK(n - length(efp::fst(mode_res.value())) == length(in) - length(efp::fst(res.value())));
+        CHECK(efp::snd(mode_res.value()) == efp::snd(res.value()));
+    }
+}
+
+#endif
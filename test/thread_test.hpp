@@ -0,0 +1,73 @@
+#ifndef THREAD_TEST_HPP_
+#define THREAD_TEST_HPP_
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("A grammar could be shared by threads", "[thread]")
+{
+    // Nested lists, with a Rule for the recursion, a set of one_of and a first byte table of alt
+    Rule<efp::StringView, size_t, 256> list;
+    list = delimited(ch('['),
+                     separated0(one_of(",;"), alt(map(parse_uint32, [](uint32_t) { return size_t(1); }),
+                                                  map(tag("null"), [](efp::StringView) { return size_t(0); }),
+                                                  ref(list))),
+                     ch(']'));
+
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        std::string s = "[";
+        for (size_t k = 0; k < i % 7; ++k)
+            s += "[1,null;" + std::to_string(i * k) + "],";
+        s += std::to_string(i) + (i % 5 == 0 ? "" : "]");
+        inputs.push_back(s);
+    }
+
+    // Results of a single thread
+    std::vector<long> expected;
+    for (const auto &s : inputs)
+    {
+        const auto res = list(efp::StringView(s.data(), s.size()));
+        expected.push_back(res ? static_cast<long>(snd(res.value())) : -1);
+    }
+
+    CHECK(expected[1] == 2);
+    CHECK(expected[5] == -1);
+
+    const size_t thread_count = 4;
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&]()
+                             {
+                                 for (size_t round = 0; round < 200; ++round)
+                                 {
+                                     for (size_t i = 0; i < inputs.size(); ++i)
+                                     {
+                                         const auto res = list(efp::StringView(inputs[i].data(), inputs[i].size()));
+                                         const long count = res ? static_cast<long>(snd(res.value())) : -1;
+                                         if (count != expected[i])
+                                             ++mismatches;
+                                     }
+                                 } });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    CHECK(mismatches == 0);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef TOKEN_PARSER_TEST_HPP_
+#define TOKEN_PARSER_TEST_HPP_
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+namespace token_parser_test
+{
+    struct LParen
+    {
+    };
+    struct RParen
+    {
+    };
+    struct Number
+    {
+        int value;
+    };
+    struct Comma
+    {
+    };
+
+    using Token = efp::Enum<LParen, RParen, Number, Comma>;
+}
+
+TEST_CASE("token parser works correctly", "[token]")
+{
+    using namespace token_parser_test;
+
+    const efp::Vector<Token> tokens(LParen{}, Number{1}, Comma{}, Number{2}, RParen{});
+    const auto in = span(tokens);
+
+    SECTION("Token of the alternative")
+    {
+        auto result = token<LParen>()(in);
+        CHECK(result);
+        if (result)
+        {
+            CHECK(length(fst(result.value())) == 4);
+            CHECK(snd(result.value()).index() == 0);
+        }
+    }
+
+    SECTION("Token of another alternative")
+    {
+        auto result = token<Number>()(in);
+        CHECK_FALSE(result);
+    }
+
+    SECTION("Empty input")
+    {
+        auto result = token<LParen>()(Span<Token>());
+        CHECK_FALSE(result);
+    }
+}
+
+TEST_CASE("combinators work on tokens", "[token]")
+{
+    using namespace token_parser_test;
+
+    const efp::Vector<Token> tokens(LParen{}, Number{1}, Comma{}, Number{2}, RParen{});
+    const auto in = span(tokens);
+
+    SECTION("Tuple parser")
+    {
+        auto result = tpl(token<LParen>(), token<Number>(), token<Comma>(), token<Number>(), token<RParen>())(in);
+        CHECK(result);
+        if (result)
+            CHECK(length(fst(result.value())) == 0);
+    }
+
+    SECTION("Tuple parser fails")
+    {
+        auto result = tpl(token<LParen>(), token<Number>(), token<RParen>())(in);
+        CHECK_FALSE(result);
+    }
+
+    SECTION("Alternative and delimited")
+    {
+        auto result = delimited(token<LParen>(), alt(token<Comma>(), token<Number>()), token<Comma>())(in);
+        CHECK(result);
+        if (result)
+        {
+            CHECK(length(fst(result.value())) == 2);
+            CHECK(snd(result.value()).index() == 2);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef UNICODE_PARSER_TEST_HPP_
+#define UNICODE_PARSER_TEST_HPP_
+
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "parser.hpp"
+// #include "test_common.hpp"
+
+using namespace efp::parser;
+
+TEST_CASE("utf8_char works correctly", "[utf8_char]")
+{
+    SECTION("Code points of each length")
+    {
+        CHECK(efp::snd(utf8_char("a").value()) == U'a');
+        CHECK(efp::snd(utf8_char("\xC3\xA9").value()) == 0xE9);
+        CHECK(efp::snd(utf8_char("\xE4\xB8\xAD").value()) == 0x4E2D);
+        CHECK(efp::snd(utf8_char("\xF0\x9F\x98\x80").value()) == 0x1F600);
+
+        const auto res = utf8_char("\xC3\xA9t\xC3\xA9");
+        CHECK(efp::fst(res.value()) == "t\xC3\xA9");
+    }
+
+    SECTION("Invalid sequences")
+    {
+        CHECK_FALSE(utf8_char(""));
+        CHECK_FALSE(utf8_char("\x80"));
+        CHECK_FALSE(utf8_char("\xC3"));
+        CHECK_FALSE(utf8_char("\xC0\xAF"));
+        CHECK_FALSE(utf8_char("\xE0\x80\xAF"));
+        CHECK_FALSE(utf8_char("\xED\xA0\x80"));
+        CHECK_FALSE(utf8_char("\xF4\x90\x80\x80"));
+        CHECK_FALSE(utf8_char("\xFF"));
+    }
+}
+
+TEST_CASE("utf8_valid works correctly", "[utf8_valid]")
+{
+    SECTION("Valid input")
+    {
+        const std::string ascii(100, 'x');
+        const auto res = utf8_valid(efp::StringView(ascii.data(), ascii.size()));
+        CHECK(efp::snd(res.value()).size() == 100);
+
+        const std::string mixed = ascii + "\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80" + ascii;
+        CHECK(efp::snd(utf8_valid(efp::StringView(mixed.data(), mixed.size())).value()).size() == mixed.size());
+    }
+
+    SECTION("Stops at the first invalid sequence")
+    {
+        const std::string prefix = std::string(40, 'a') + "\xC3\xA9" + std::string(30, 'b');
+        const char *invalids[] = {"\x80", "\xC3(", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xFF", "\xC0\xAF"};
+
+        for (const auto invalid : invalids)
+        {
+            for (size_t pad = 0; pad < 40; ++pad)
+            {
+                const std::string in = prefix + std::string(pad, 'c') + invalid + std::string(40, 'd');
+                const auto res = utf8_valid(efp::StringView(in.data(), in.size()));
+                CHECK(efp::snd(res.value()).size() == prefix.size() + pad);
+            }
+        }
+    }
+
+    SECTION("Sequence cut at the end")
+    {
+        const std::string in = std::string(31, 'a') + "\xE4\xB8";
+        CHECK(efp::snd(utf8_valid(efp::StringView(in.data(), in.size())).value()).size() == 31);
+    }
+
+    SECTION("Sequences across the 32-byte blocks agree with decoding one code point at a time")
+    {
+        // On an SSSE3 build, utf8_valid validates 32 bytes at a time, and each sequence is moved across a block end
+        const char *sequences[] = {"\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF",
+                                   "\xC3", "\xE4\xB8", "\xF0\x9F\x98", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80",
+                                   "\xF4\x90\x80\x80", "\x80", "\xFF", "\xC3\xA9\xBF"};
+
+        std::string mixed;
+        while (mixed.size() < 70)
+            mixed += "\xC3\xA9" "a" "\xE4\xB8\xAD";
+
+        for (const std::string &fill : {std::string(70, 'a'), mixed})
+        {
+            for (const auto sequence : sequences)
+            {
+                for (size_t offset = 26; offset < 70; ++offset)
+                {
+                    const std::string in = fill.substr(0, offset) + sequence + std::string(40, 'z');
+                    const auto res = utf8_valid(efp::StringView(in.data(), in.size()));
+                    CHECK(efp::snd(res.value()).size() ==
+                          efp::parser::detail::utf8_valid_prefix_scalar(in.data(), in.size()));
+                }
+            }
+        }
+    }
+
+    SECTION("Valid text, with a byte replaced, agrees with decoding one code point at a time")
+    {
+        const char32_t firsts[] = {0x20, 0x80, 0x800, 0xE000, 0x10000};
+        const char32_t counts[] = {0x5F, 0x780, 0xD000 - 0x800, 0x2000, 0x100000};
+        uint32_t state = 777;
+
+        for (int n = 0; n < 2000; ++n)
+        {
+            std::string in;
+            while (in.size() < static_cast<size_t>(100 + n % 61))
+            {
+                state = state * 1103515245 + 12345;
+                const size_t range = (state >> 16) % 5;
+                state = state * 1103515245 + 12345;
+                char buffer[4];
+                in.append(buffer, efp::parser::detail::encode_utf8(firsts[range] + (state >> 8) % counts[range], buffer));
+            }
+
+            if (n % 2)
+            {
+                state = state * 1103515245 + 12345;
+                in[(state >> 16) % in.size()] = static_cast<char>(state >> 8);
+            }
+
+            const auto res = utf8_valid(efp::StringView(in.data(), in.size()));
+            CHECK(efp::snd(res.value()).size() == efp::parser::detail::utf8_valid_prefix_scalar(in.data(), in.size()));
+        }
+    }
+
+    SECTION("Agrees with decoding one code point at a time")
+    {
+        const unsigned char bytes[] = {'a', 'z', ' ', 0x80, 0xBF, 0xC2, 0xC3, 0xDF, 0xE0, 0xE4, 0xED, 0xEF, 0xF0, 0xF4, 0xF5, 0xFF};
+        uint32_t state = 12345;
+
+        for (int n = 0; n < 2000; ++n)
+        {
+            std::string in;
+            const size_t size = 1 + n % 97;
+            for (size_t i = 0; i < size; ++i)
+            {
+                state = state * 1103515245 + 12345;
+                in.push_back(static_cast<char>(bytes[(state >> 16) % sizeof(bytes)]));
+            }
+
+            const auto res = utf8_valid(efp::StringView(in.data(), in.size()));
+            CHECK(efp::snd(res.value()).size() == efp::parser::detail::utf8_valid_prefix_scalar(in.data(), in.size()));
+        }
+    }
+}
+
+TEST_CASE("utf8 character classes work correctly", "[utf8_alpha]")
+{
+    SECTION("utf8_alpha1")
+    {
+        const auto res = utf8_alpha1("caf\xC3\xA9_bar");
+        CHECK(efp::snd(res.value()) == "caf\xC3\xA9");
+        CHECK(efp::fst(res.value()) == "_bar");
+
+        CHECK(efp::snd(utf8_alpha1("\xD0\xBF\xD1\x80\xD0\xB8 ").value()) == "\xD0\xBF\xD1\x80\xD0\xB8");
+        CHECK(efp::snd(utf8_alpha1("\xE4\xB8\xAD\xE6\x96\x87").value()) == "\xE4\xB8\xAD\xE6\x96\x87");
+        CHECK_FALSE(utf8_alpha1("1abc"));
+        CHECK_FALSE(utf8_alpha1("\xC3("));
+    }
+
+    SECTION("utf8_alpha0")
+    {
+        const auto res = utf8_alpha0("\xE2\x82\xAC""1");
+        CHECK(efp::snd(res.value()) == "");
+    }
+
+    SECTION("utf8_alphanumeric1")
+    {
+        CHECK(efp::snd(utf8_alphanumeric1("x\xC3\xA9" "42 ").value()) == "x\xC3\xA9" "42");
+        CHECK_FALSE(utf8_alphanumeric1("-"));
+    }
+
+    SECTION("utf8_alphanumeric1 takes the decimal digits of other scripts")
+    {
+        // Arabic-Indic 3, Devanagari 5 and fullwidth 1
+        CHECK(efp::snd(utf8_alphanumeric1("x\xD9\xA3\xE0\xA5\xAB\xEF\xBC\x91-").value()) ==
+              "x\xD9\xA3\xE0\xA5\xAB\xEF\xBC\x91");
+        CHECK(efp::snd(utf8_alpha0("\xD9\xA3").value()) == "");
+    }
+
+    SECTION("utf8_alpha1 takes the Alphabetic property, with the vowel signs of the Brahmic scripts")
+    {
+        // Devanagari avagraha, om and qa
+        CHECK(efp::snd(utf8_alpha1("\xE0\xA4\xBD\xE0\xA5\x90\xE0\xA5\x98 ").value()) == "\xE0\xA4\xBD\xE0\xA5\x90\xE0\xA5\x98");
+        // A virama is not Alphabetic, and ends the run
+        CHECK(efp::snd(utf8_alpha1("\xE0\xA4\xA8\xE0\xA4\xAE\xE0\xA4\xB8\xE0\xA5\x8D").value()) ==
+              "\xE0\xA4\xA8\xE0\xA4\xAE\xE0\xA4\xB8");
+
+        const char *words[] = {
+            "\xE0\xB9\x80\xE0\xB8\xA1\xE0\xB8\xB7\xE0\xB8\xAD\xE0\xB8\x87",                         // Thai
+            "\xE0\xA6\xAC\xE0\xA6\xBE\xE0\xA6\x82\xE0\xA6\xB2\xE0\xA6\xBE",                         // Bengali
+            "\xE0\xA8\xAA\xE0\xA9\xB0\xE0\xA8\x9C\xE0\xA8\xBE\xE0\xA8\xAC\xE0\xA9\x80",             // Gurmukhi
+            "\xE0\xAA\x97\xE0\xAB\x81\xE0\xAA\x9C\xE0\xAA\xB0\xE0\xAA\xBE\xE0\xAA\xA4\xE0\xAB\x80", // Gujarati
+            "\xE0\xAE\xA4\xE0\xAE\xAE\xE0\xAE\xBF\xE0\xAE\xB4",                                     // Tamil
+            "\xE0\xB0\xA4\xE0\xB1\x86\xE0\xB0\xB2\xE0\xB1\x81\xE0\xB0\x97\xE0\xB1\x81",             // Telugu
+            "\xE0\xB2\x95\xE0\xB2\xA8",                                                             // Kannada
+            "\xE0\xB4\xAE\xE0\xB4\xB2\xE0\xB4\xAF\xE0\xB4\xBE\xE0\xB4\xB3\xE0\xB4\x82",             // Malayalam
+            "\xE1\x8A\xA2\xE1\x89\xB5\xE1\x8B\xAE\xE1\x8C\xB5\xE1\x8B\xAB",                         // Ethiopic
+            "\xE1\x9E\x81",                                                                         // Khmer
+        };
+        for (const char *word : words)
+        {
+            const std::string in = std::string(word) + "-";
+            const auto res = utf8_alpha1(efp::StringView(in.data(), in.size()));
+            REQUIRE(res);
+            CHECK(efp::snd(res.value()) == word);
+        }
+    }
+
+    SECTION("utf8_space")
+    {
+        CHECK(efp::snd(utf8_space1(" \t\xC2\xA0\xE3\x80\x80x").value()) == " \t\xC2\xA0\xE3\x80\x80");
+        CHECK_FALSE(utf8_space1("x"));
+        CHECK(efp::snd(utf8_space0("x").value()) == "");
+    }
+
+    SECTION("Same ASCII classes as alpha1, alphanumeric1 and multispace1")
+    {
+        for (int c = 1; c < 128; ++c)
+        {
+            const char in[] = {static_cast<char>(c), 0};
+            CHECK(static_cast<bool>(utf8_alpha1(in)) == static_cast<bool>(alpha1(in)));
+            CHECK(static_cast<bool>(utf8_alphanumeric1(in)) == static_cast<bool>(alphanumeric1(in)));
+            CHECK(static_cast<bool>(utf8_space1(in)) == static_cast<bool>(multispace1(in)));
+        }
+    }
+}
+
+#endif